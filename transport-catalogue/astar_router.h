@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "dijkstra_router.h"
+#include "graph.h"
+#include "router.h"
+
+namespace graph {
+// ------------ [A* Router] Definition ------------
+//                                                +
+//                                                + -----------
+// ------------------------------------------------ A* Router +
+
+    // Point-to-point engine: Dijkstra ordered by weight + [Heuristic](vertex, target), a lower bound
+    // of the remaining weight. A consistent heuristic settles every vertex once and the search
+    // stops at the target, so local queries explore only the area around the route
+    template <typename Weight, typename Heuristic>
+    class AStarRouter final : public RoutingEngine<Weight> {
+    private:
+        using Graph = CsrGraph<Weight>;
+
+    public:
+        using typename RoutingEngine<Weight>::RouteInfo;
+
+        AStarRouter(const Graph& graph, Heuristic heuristic);
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const override;
+
+    private:
+        // Heuristic values are evaluated once per reached vertex
+        struct Workspace final {
+            detail::SearchWorkspace<Weight> search;
+            std::vector<Weight> potentials;
+        };
+
+        static Workspace& GetWorkspace();
+
+        static constexpr Weight ZERO_WEIGHT{};
+        const Graph& graph_;
+        Heuristic heuristic_;
+    };
+
+//
+//
+//                                                + ------------------
+// ------------------------------------------------ Landmark Heuristic +
+
+    // ALT heuristic: exact weights to and from a few landmarks bound the remaining weight
+    // by the triangle inequality. Every part of the graph the chosen landmarks don't reach gets one first,
+    // then landmarks are picked one by one as far as possible from the chosen ones
+    template <typename Weight>
+    class LandmarkHeuristic final {
+    private:
+        using Graph = CsrGraph<Weight>;
+
+    public:
+        LandmarkHeuristic(const Graph& graph, std::size_t landmark_count);
+
+        Weight operator()(VertexId vertex, VertexId target) const;
+
+    private:
+        struct ReverseArc final {
+            VertexId from;
+            Weight weight;
+        };
+
+        template <typename ForEachArc>
+        static std::vector<Weight> ComputeWeights(std::size_t vertex_count, VertexId source, ForEachArc for_each_arc);
+
+        static constexpr Weight ZERO_WEIGHT{};
+        static constexpr Weight UNREACHABLE = std::numeric_limits<Weight>::max();
+
+        std::size_t landmark_count_ = 0;
+
+        // Row [vertex] holds the weights from / to every landmark
+        std::vector<Weight> from_landmarks_;
+        std::vector<Weight> to_landmarks_;
+    };
+
+// ------------ [A* Router] Realization ------------
+//                                                 +
+//                                                 + -----------
+// ------------------------------------------------- A* Router +
+
+    template <typename Weight, typename Heuristic>
+    AStarRouter<Weight, Heuristic>::AStarRouter(const Graph& graph, Heuristic heuristic)
+        : graph_(graph)
+        , heuristic_(std::move(heuristic)) {
+
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            if (graph.GetEdge(edge_id).weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+        }
+    }
+
+    template <typename Weight, typename Heuristic>
+    typename AStarRouter<Weight, Heuristic>::Workspace& AStarRouter<Weight, Heuristic>::GetWorkspace() {
+        thread_local Workspace workspace;
+        return workspace;
+    }
+
+    template <typename Weight, typename Heuristic>
+    std::optional<typename AStarRouter<Weight, Heuristic>::RouteInfo> AStarRouter<Weight, Heuristic>::BuildRoute(VertexId from,
+        VertexId to) const {
+        Workspace& workspace = GetWorkspace();
+        detail::SearchWorkspace<Weight>& search = workspace.search;
+
+        search.Prepare(graph_.GetVertexCount());
+        if (workspace.potentials.size() < graph_.GetVertexCount()) {
+            workspace.potentials.resize(graph_.GetVertexCount());
+        }
+
+        workspace.potentials[from] = heuristic_(from, to);
+        search.Reach(from, ZERO_WEIGHT, detail::NO_EDGE);
+        search.Push(workspace.potentials[from], from);
+
+        while (!search.queue.IsEmpty()) {
+            const auto [estimate, vertex] = search.Pop();
+            const Weight weight = search.weights[vertex];
+
+            if (estimate > weight + workspace.potentials[vertex]) {
+                continue;
+            }
+
+            if (vertex == to) {
+                break;
+            }
+
+            for (const auto& edge : graph_.GetOutgoingEdges(vertex)) {
+                const Weight candidate_weight = weight + edge.weight;
+
+                if (!search.IsReached(edge.to)) {
+                    workspace.potentials[edge.to] = heuristic_(edge.to, to);
+                }
+                else if (!(candidate_weight < search.weights[edge.to])) {
+                    continue;
+                }
+
+                search.Reach(edge.to, candidate_weight, edge.id);
+                search.Push(candidate_weight + workspace.potentials[edge.to], edge.to);
+            }
+        }
+
+        if (!search.IsReached(to)) {
+            return std::nullopt;
+        }
+
+        std::vector<EdgeId> edges;
+        for (EdgeId edge_id = search.prev_edges[to]; edge_id != detail::NO_EDGE;
+            edge_id = search.prev_edges[graph_.GetEdge(edge_id).from])
+        {
+            edges.push_back(edge_id);
+        }
+
+        std::reverse(edges.begin(), edges.end());
+        return RouteInfo{ search.weights[to], std::move(edges) };
+    }
+
+//
+//
+//                                                 + --------------------
+// ------------------------------------------------- Landmark Heuristic +
+
+    template <typename Weight>
+    LandmarkHeuristic<Weight>::LandmarkHeuristic(const Graph& graph, std::size_t landmark_count) {
+        const std::size_t vertex_count = graph.GetVertexCount();
+        landmark_count_ = std::min(landmark_count, vertex_count);
+
+        std::vector<std::size_t> reverse_offsets(vertex_count + 1);
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            ++reverse_offsets[graph.GetEdge(edge_id).to + 1];
+        }
+
+        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+            reverse_offsets[vertex + 1] += reverse_offsets[vertex];
+        }
+
+        std::vector<ReverseArc> reverse_arcs(graph.GetEdgeCount());
+        std::vector<std::size_t> reverse_ends(reverse_offsets.begin(), reverse_offsets.end() - 1);
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            const auto& edge = graph.GetEdge(edge_id);
+            reverse_arcs[reverse_ends[edge.to]++] = ReverseArc{ edge.from, edge.weight };
+        }
+
+        auto for_each_outgoing = [&graph](VertexId vertex, auto relax) {
+            for (const auto& edge : graph.GetOutgoingEdges(vertex)) {
+                relax(edge.to, edge.weight);
+            }
+        };
+
+        auto for_each_incoming = [&reverse_offsets, &reverse_arcs](VertexId vertex, auto relax) {
+            for (std::size_t arc = reverse_offsets[vertex]; arc < reverse_offsets[vertex + 1]; ++arc) {
+                relax(reverse_arcs[arc].from, reverse_arcs[arc].weight);
+            }
+        };
+
+        // The weight from the chosen landmarks to every vertex, and whether a vertex reaches or is reached by any of them
+        std::vector<Weight> nearest_landmark(vertex_count, UNREACHABLE);
+        std::vector<bool> is_covered(vertex_count, false);
+        std::vector<bool> is_landmark(vertex_count, false);
+
+        // A part of the graph no landmark reaches gets no bound at all, so its best connected vertex is seeded first.
+        // Otherwise the farthest reached vertex that is not a landmark yet. Vertices without edges bound nothing
+        auto choose_landmark = [&]() -> std::optional<VertexId> {
+            std::optional<VertexId> seed;
+            for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+                const std::size_t degree = graph.GetOutgoingEdges(vertex).size();
+
+                if (!is_covered[vertex] && degree > 0 && (!seed.has_value() || degree > graph.GetOutgoingEdges(*seed).size())) {
+                    seed = vertex;
+                }
+            }
+
+            if (seed.has_value()) {
+                return seed;
+            }
+
+            std::optional<VertexId> farthest;
+            for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+                if (!is_landmark[vertex] && nearest_landmark[vertex] != UNREACHABLE
+                    && (!farthest.has_value() || nearest_landmark[vertex] > nearest_landmark[*farthest]))
+                {
+                    farthest = vertex;
+                }
+            }
+
+            return farthest;
+        };
+
+        std::vector<std::vector<Weight>> from_weights;
+        std::vector<std::vector<Weight>> to_weights;
+
+        while (from_weights.size() < landmark_count_) {
+            const std::optional<VertexId> landmark = choose_landmark();
+
+            if (!landmark.has_value()) {
+                break;
+            }
+
+            from_weights.push_back(ComputeWeights(vertex_count, *landmark, for_each_outgoing));
+            to_weights.push_back(ComputeWeights(vertex_count, *landmark, for_each_incoming));
+            is_landmark[*landmark] = true;
+
+            for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+                nearest_landmark[vertex] = std::min(nearest_landmark[vertex], from_weights.back()[vertex]);
+                is_covered[vertex] = is_covered[vertex] || from_weights.back()[vertex] != UNREACHABLE
+                    || to_weights.back()[vertex] != UNREACHABLE;
+            }
+        }
+
+        // Fewer landmarks are kept when no vertex is left to choose
+        landmark_count_ = from_weights.size();
+        from_landmarks_.resize(vertex_count * landmark_count_);
+        to_landmarks_.resize(vertex_count * landmark_count_);
+
+        for (std::size_t index = 0; index < landmark_count_; ++index) {
+            for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+                from_landmarks_[vertex * landmark_count_ + index] = from_weights[index][vertex];
+                to_landmarks_[vertex * landmark_count_ + index] = to_weights[index][vertex];
+            }
+        }
+    }
+
+    template <typename Weight>
+    template <typename ForEachArc>
+    std::vector<Weight> LandmarkHeuristic<Weight>::ComputeWeights(std::size_t vertex_count, VertexId source, ForEachArc for_each_arc) {
+        std::vector<Weight> weights(vertex_count, UNREACHABLE);
+        detail::SearchQueue<Weight> queue;
+
+        weights[source] = ZERO_WEIGHT;
+        queue.Push(ZERO_WEIGHT, source);
+
+        while (!queue.IsEmpty()) {
+            const auto [weight, vertex] = queue.Pop();
+
+            if (weight > weights[vertex]) {
+                continue;
+            }
+
+            for_each_arc(vertex, [&weights, &queue, weight](VertexId next, Weight arc_weight) {
+                const Weight candidate_weight = weight + arc_weight;
+
+                if (candidate_weight < weights[next]) {
+                    weights[next] = candidate_weight;
+                    queue.Push(candidate_weight, next);
+                }
+            });
+        }
+
+        return weights;
+    }
+
+    template <typename Weight>
+    Weight LandmarkHeuristic<Weight>::operator()(VertexId vertex, VertexId target) const {
+        const Weight* from_vertex = from_landmarks_.data() + vertex * landmark_count_;
+        const Weight* from_target = from_landmarks_.data() + target * landmark_count_;
+        const Weight* to_vertex = to_landmarks_.data() + vertex * landmark_count_;
+        const Weight* to_target = to_landmarks_.data() + target * landmark_count_;
+
+        Weight bound = ZERO_WEIGHT;
+        for (std::size_t index = 0; index < landmark_count_; ++index) {
+            // landmark -> vertex -> target
+            if (from_target[index] != UNREACHABLE && from_vertex[index] != UNREACHABLE && from_target[index] > from_vertex[index]) {
+                bound = std::max(bound, from_target[index] - from_vertex[index]);
+            }
+
+            // vertex -> target -> landmark
+            if (to_vertex[index] != UNREACHABLE && to_target[index] != UNREACHABLE && to_vertex[index] > to_target[index]) {
+                bound = std::max(bound, to_vertex[index] - to_target[index]);
+            }
+        }
+
+        return bound;
+    }
+} // namespace graph
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph.h"
+#include "router.h"
+
+namespace graph {
+// ------------ [Blocked Floyd Router] Definition ------------
+//                                                           +
+//                                                           + ----------------------
+// ----------------------------------------------------------- Blocked Floyd Router +
+
+    // All-pairs engine over flat row-major matrices. Floyd-Warshall runs tile by tile: the pivot tile,
+    // then its row and column, then the remaining tiles, each phase spread across the hardware threads.
+    // Unreachable pairs hold the infinity sentinel and the NO_PREV_EDGE predecessor.
+    // With 32-bit fixed-point weights a pair takes 8 bytes instead of 12 with doubles
+    template <typename Weight>
+    class BlockedFloydRouter final : public RoutingEngine<Weight> {
+    private:
+        using Graph = CsrGraph<Weight>;
+        using PrevEdge = std::uint32_t;
+
+    public:
+        using typename RoutingEngine<Weight>::RouteInfo;
+
+        explicit BlockedFloydRouter(const Graph& graph);
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const override;
+
+    private:
+        void InitializeMatrices();
+        void RelaxThroughBlock(std::size_t block_through);
+
+        // Relaxes tile (row_block, column_block) through every vertex of [block_through]
+        void RelaxTile(std::size_t row_block, std::size_t column_block, std::size_t block_through);
+
+        template <typename Function>
+        static void ParallelFor(std::size_t count, Function function);
+
+        static constexpr Weight ZERO_WEIGHT{};
+        // Half of the integer range, so that the sum of two sentinels doesn't overflow
+        static constexpr Weight INFINITE_WEIGHT = std::numeric_limits<Weight>::has_infinity
+            ? std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::max() / 2;
+        static constexpr PrevEdge NO_PREV_EDGE = std::numeric_limits<PrevEdge>::max();
+
+        // 64 x 64 tiles keep the three tiles of one relaxation within L2
+        static constexpr std::size_t BLOCK_SIZE = 64;
+
+        const Graph& graph_;
+        std::size_t vertex_count_;
+        std::size_t block_count_;
+        std::size_t stride_;
+        std::vector<Weight> weights_;
+        std::vector<PrevEdge> prev_edges_;
+    };
+
+// ------------ [Blocked Floyd Router] Realization ------------
+//                                                            +
+//                                                            + -------------------
+// ------------------------------------------------------------ Matrix Building +
+
+    template <typename Weight>
+    BlockedFloydRouter<Weight>::BlockedFloydRouter(const Graph& graph)
+        : graph_(graph)
+        , vertex_count_(graph.GetVertexCount())
+        , block_count_((graph.GetVertexCount() + BLOCK_SIZE - 1) / BLOCK_SIZE)
+        , stride_(block_count_ * BLOCK_SIZE) {
+
+        if (graph.GetEdgeCount() >= NO_PREV_EDGE) {
+            throw std::length_error("Too many edges for the all-pairs matrix");
+        }
+
+        InitializeMatrices();
+
+        for (std::size_t block_through = 0; block_through < block_count_; ++block_through) {
+            RelaxThroughBlock(block_through);
+        }
+    }
+
+    // The matrices are padded up to whole tiles; padding vertices stay isolated
+    template <typename Weight>
+    void BlockedFloydRouter<Weight>::InitializeMatrices() {
+        weights_.assign(stride_ * stride_, INFINITE_WEIGHT);
+        prev_edges_.assign(stride_ * stride_, NO_PREV_EDGE);
+
+        for (VertexId vertex = 0; vertex < stride_; ++vertex) {
+            weights_[vertex * stride_ + vertex] = ZERO_WEIGHT;
+        }
+
+        for (EdgeId edge_id = 0; edge_id < graph_.GetEdgeCount(); ++edge_id) {
+            const auto& edge = graph_.GetEdge(edge_id);
+
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+
+            const std::size_t cell = edge.from * stride_ + edge.to;
+            if (edge.weight < weights_[cell]) {
+                weights_[cell] = edge.weight;
+                prev_edges_[cell] = static_cast<PrevEdge>(edge_id);
+            }
+        }
+    }
+
+//
+//
+//                                                            + -------------------
+// ------------------------------------------------------------ Blocked Relaxation +
+
+    template <typename Weight>
+    void BlockedFloydRouter<Weight>::RelaxThroughBlock(std::size_t block_through) {
+        RelaxTile(block_through, block_through, block_through);
+
+        // Pivot row and pivot column tiles depend only on the pivot tile
+        ParallelFor(2 * block_count_, [this, block_through](std::size_t task) {
+            const std::size_t block = task / 2;
+
+            if (block == block_through) {
+                return;
+            }
+
+            if (task % 2 == 0) {
+                RelaxTile(block_through, block, block_through);
+            }
+            else {
+                RelaxTile(block, block_through, block_through);
+            }
+        });
+
+        // The remaining tiles depend only on the pivot row and column
+        ParallelFor(block_count_ * block_count_, [this, block_through](std::size_t task) {
+            const std::size_t row_block = task / block_count_;
+            const std::size_t column_block = task % block_count_;
+
+            if (row_block != block_through && column_block != block_through) {
+                RelaxTile(row_block, column_block, block_through);
+            }
+        });
+    }
+
+    template <typename Weight>
+    void BlockedFloydRouter<Weight>::RelaxTile(std::size_t row_block, std::size_t column_block, std::size_t block_through) {
+        const std::size_t row_begin = row_block * BLOCK_SIZE;
+        const std::size_t column_begin = column_block * BLOCK_SIZE;
+        const std::size_t through_begin = block_through * BLOCK_SIZE;
+
+        for (std::size_t vertex_through = through_begin; vertex_through < through_begin + BLOCK_SIZE; ++vertex_through) {
+            const Weight* through_weights = weights_.data() + vertex_through * stride_ + column_begin;
+            const PrevEdge* through_prev_edges = prev_edges_.data() + vertex_through * stride_ + column_begin;
+
+            for (std::size_t vertex_from = row_begin; vertex_from < row_begin + BLOCK_SIZE; ++vertex_from) {
+                const Weight weight_from = weights_[vertex_from * stride_ + vertex_through];
+
+                if (weight_from == INFINITE_WEIGHT) {
+                    continue;
+                }
+
+                Weight* row_weights = weights_.data() + vertex_from * stride_ + column_begin;
+                PrevEdge* row_prev_edges = prev_edges_.data() + vertex_from * stride_ + column_begin;
+
+                for (std::size_t column = 0; column < BLOCK_SIZE; ++column) {
+                    const Weight candidate_weight = weight_from + through_weights[column];
+
+                    if (candidate_weight < row_weights[column]) {
+                        row_weights[column] = candidate_weight;
+                        row_prev_edges[column] = through_prev_edges[column];
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Weight>
+    template <typename Function>
+    void BlockedFloydRouter<Weight>::ParallelFor(std::size_t count, Function function) {
+        const std::size_t thread_count = std::clamp<std::size_t>(count, 1,
+            std::max(1U, std::thread::hardware_concurrency()));
+
+        std::atomic<std::size_t> next_task = 0;
+        auto worker = [&next_task, count, &function]() {
+            for (std::size_t task = next_task++; task < count; task = next_task++) {
+                function(task);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 1; thread < thread_count; ++thread) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+//
+//
+//                                                            + -------
+// ------------------------------------------------------------ Query +
+
+    template <typename Weight>
+    std::optional<typename BlockedFloydRouter<Weight>::RouteInfo> BlockedFloydRouter<Weight>::BuildRoute(VertexId from,
+        VertexId to) const {
+        const std::size_t row = from * stride_;
+        const Weight weight = weights_.at(row + to);
+
+        if (weight == INFINITE_WEIGHT) {
+            return std::nullopt;
+        }
+
+        std::vector<EdgeId> edges;
+        for (PrevEdge edge_id = prev_edges_[row + to]; edge_id != NO_PREV_EDGE;
+            edge_id = prev_edges_[row + graph_.GetEdge(edge_id).from])
+        {
+            edges.push_back(edge_id);
+        }
+
+        std::reverse(edges.begin(), edges.end());
+        return RouteInfo{ weight, std::move(edges) };
+    }
+} // namespace graph
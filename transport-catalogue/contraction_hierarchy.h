@@ -0,0 +1,458 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dijkstra_router.h"
+#include "csr_graph.h"
+#include "graph.h"
+#include "router.h"
+
+namespace graph {
+// ------------ [Contraction Hierarchy Router] Definition ------------
+//                                                                   +
+//                                                                   + ------------------------------
+// ------------------------------------------------------------------- Contraction Hierarchy Router +
+
+    // Point-to-point engine: vertices are contracted one by one (ordered by edge difference), adding shortcuts
+    // that preserve the shortest paths among the remaining vertices. A query is a bidirectional Dijkstra
+    // that only climbs the hierarchy; shortcuts are unpacked back into the original edge ids
+    template <typename Weight>
+    class ContractionHierarchyRouter final : public RoutingEngine<Weight> {
+    private:
+        using Graph = CsrGraph<Weight>;
+
+    public:
+        using typename RoutingEngine<Weight>::RouteInfo;
+
+        explicit ContractionHierarchyRouter(const Graph& graph);
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const override;
+        std::size_t GetShortcutCount() const;
+
+    private:
+        // Original edges keep their ids. A shortcut replaces the path [first] + [second]
+        struct HierarchyEdge final {
+            VertexId from;
+            VertexId to;
+            Weight weight;
+            EdgeId first = detail::NO_EDGE;
+            EdgeId second = detail::NO_EDGE;
+        };
+
+        struct Arc final {
+            VertexId to;
+            Weight weight;
+            EdgeId edge;
+        };
+
+        struct ContractionState final {
+            std::vector<std::vector<Arc>> outgoing;
+            std::vector<std::vector<Arc>> incoming;
+            std::vector<bool> is_contracted;
+            std::vector<std::int64_t> deleted_neighbours;
+            detail::SearchWorkspace<Weight> witness;
+        };
+
+        using Workspace = detail::SearchWorkspace<Weight>;
+
+        void ContractVertices(ContractionState& state);
+        std::int64_t ComputePriority(ContractionState& state, VertexId vertex);
+        std::size_t ProcessShortcuts(ContractionState& state, VertexId vertex, bool to_add);
+        void SearchWitnesses(ContractionState& state, VertexId source, VertexId excluded, Weight max_weight) const;
+        std::vector<Arc> CollectLightestArcs(const ContractionState& state, const std::vector<Arc>& arcs, VertexId vertex) const;
+
+        void BuildSearchGraphs();
+        void UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& edges) const;
+
+        static std::pair<Workspace, Workspace>& GetWorkspaces();
+
+        static constexpr Weight ZERO_WEIGHT{};
+        static constexpr std::size_t WITNESS_SETTLE_LIMIT = 500;
+
+        std::size_t vertex_count_;
+        std::size_t original_edge_count_;
+        std::vector<HierarchyEdge> edges_;
+        std::vector<std::uint32_t> ranks_;
+
+        // Arcs towards higher ranks in CSR layout: forward ones are stored at their tail,
+        // backward ones (searched from the target) at their head
+        std::vector<std::size_t> upward_offsets_;
+        std::vector<Arc> upward_arcs_;
+        std::vector<std::size_t> downward_offsets_;
+        std::vector<Arc> downward_arcs_;
+    };
+
+// ------------ [Contraction Hierarchy Router] Realization ------------
+//                                                                    +
+//                                                                    + -------------------
+// -------------------------------------------------------------------- Preprocessing Facade +
+
+    template <typename Weight>
+    ContractionHierarchyRouter<Weight>::ContractionHierarchyRouter(const Graph& graph)
+        : vertex_count_(graph.GetVertexCount())
+        , original_edge_count_(graph.GetEdgeCount())
+        , ranks_(graph.GetVertexCount()) {
+
+        ContractionState state {
+            .outgoing = std::vector<std::vector<Arc>>(vertex_count_),
+            .incoming = std::vector<std::vector<Arc>>(vertex_count_),
+            .is_contracted = std::vector<bool>(vertex_count_),
+            .deleted_neighbours = std::vector<std::int64_t>(vertex_count_),
+            .witness = {}
+        };
+
+        edges_.reserve(original_edge_count_);
+        for (EdgeId edge_id = 0; edge_id < original_edge_count_; ++edge_id) {
+            const auto& edge = graph.GetEdge(edge_id);
+
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+
+            edges_.push_back(HierarchyEdge{ edge.from, edge.to, edge.weight });
+
+            if (edge.from != edge.to) {
+                state.outgoing[edge.from].push_back(Arc{ edge.to, edge.weight, edge_id });
+                state.incoming[edge.to].push_back(Arc{ edge.from, edge.weight, edge_id });
+            }
+        }
+
+        ContractVertices(state);
+        BuildSearchGraphs();
+    }
+
+    template <typename Weight>
+    std::size_t ContractionHierarchyRouter<Weight>::GetShortcutCount() const {
+        return edges_.size() - original_edge_count_;
+    }
+
+//
+//
+//                                                                    + ---------------
+// -------------------------------------------------------------------- Contraction +
+
+    template <typename Weight>
+    void ContractionHierarchyRouter<Weight>::ContractVertices(ContractionState& state) {
+        using QueueEntry = std::pair<std::int64_t, VertexId>;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            queue.push({ ComputePriority(state, vertex), vertex });
+        }
+
+        std::uint32_t rank = 0;
+        while (!queue.empty()) {
+            const VertexId vertex = queue.top().second;
+            queue.pop();
+
+            // Lazy update: the priority may have grown since the vertex was queued
+            const std::int64_t priority = ComputePriority(state, vertex);
+            if (!queue.empty() && priority > queue.top().first) {
+                queue.push({ priority, vertex });
+                continue;
+            }
+
+            ProcessShortcuts(state, vertex, true);
+            state.is_contracted[vertex] = true;
+            ranks_[vertex] = rank++;
+
+            auto is_contracted = [&state](const Arc& arc) {
+                return state.is_contracted[arc.to];
+            };
+
+            for (const Arc& arc : state.incoming[vertex]) {
+                ++state.deleted_neighbours[arc.to];
+                std::erase_if(state.outgoing[arc.to], is_contracted);
+            }
+
+            for (const Arc& arc : state.outgoing[vertex]) {
+                ++state.deleted_neighbours[arc.to];
+                std::erase_if(state.incoming[arc.to], is_contracted);
+            }
+
+            state.incoming[vertex] = {};
+            state.outgoing[vertex] = {};
+        }
+    }
+
+    template <typename Weight>
+    std::int64_t ContractionHierarchyRouter<Weight>::ComputePriority(ContractionState& state, VertexId vertex) {
+        const std::int64_t shortcut_count = static_cast<std::int64_t>(ProcessShortcuts(state, vertex, false));
+        const std::int64_t removed_count = static_cast<std::int64_t>(state.incoming[vertex].size() + state.outgoing[vertex].size());
+
+        return shortcut_count - removed_count + state.deleted_neighbours[vertex];
+    }
+
+    // Counts (and optionally adds) the shortcuts needed to contract [vertex]
+    template <typename Weight>
+    std::size_t ContractionHierarchyRouter<Weight>::ProcessShortcuts(ContractionState& state, VertexId vertex, bool to_add) {
+        const std::vector<Arc> incoming = CollectLightestArcs(state, state.incoming[vertex], vertex);
+        const std::vector<Arc> outgoing = CollectLightestArcs(state, state.outgoing[vertex], vertex);
+
+        if (incoming.empty() || outgoing.empty()) {
+            return 0;
+        }
+
+        Weight max_outgoing_weight = ZERO_WEIGHT;
+        for (const Arc& arc : outgoing) {
+            max_outgoing_weight = std::max(max_outgoing_weight, arc.weight);
+        }
+
+        std::size_t shortcut_count = 0;
+        for (const Arc& in_arc : incoming) {
+            SearchWitnesses(state, in_arc.to, vertex, in_arc.weight + max_outgoing_weight);
+
+            for (const Arc& out_arc : outgoing) {
+                if (out_arc.to == in_arc.to) {
+                    continue;
+                }
+
+                const Weight via_weight = in_arc.weight + out_arc.weight;
+                if (state.witness.IsReached(out_arc.to) && state.witness.weights[out_arc.to] <= via_weight) {
+                    continue;
+                }
+
+                ++shortcut_count;
+                if (to_add) {
+                    const EdgeId shortcut_id = edges_.size();
+                    edges_.push_back(HierarchyEdge{ in_arc.to, out_arc.to, via_weight, in_arc.edge, out_arc.edge });
+
+                    state.outgoing[in_arc.to].push_back(Arc{ out_arc.to, via_weight, shortcut_id });
+                    state.incoming[out_arc.to].push_back(Arc{ in_arc.to, via_weight, shortcut_id });
+                }
+            }
+        }
+
+        return shortcut_count;
+    }
+
+    // Bounded Dijkstra among the remaining vertices, skipping [excluded]
+    template <typename Weight>
+    void ContractionHierarchyRouter<Weight>::SearchWitnesses(ContractionState& state, VertexId source,
+        VertexId excluded, Weight max_weight) const {
+        Workspace& witness = state.witness;
+        witness.Prepare(vertex_count_);
+
+        witness.Reach(source, ZERO_WEIGHT, detail::NO_EDGE);
+        witness.Push(ZERO_WEIGHT, source);
+
+        std::size_t settled_count = 0;
+        while (!witness.queue.IsEmpty() && settled_count < WITNESS_SETTLE_LIMIT) {
+            const auto [weight, vertex] = witness.Pop();
+
+            if (weight > witness.weights[vertex]) {
+                continue;
+            }
+
+            if (weight > max_weight) {
+                break;
+            }
+
+            ++settled_count;
+            for (const Arc& arc : state.outgoing[vertex]) {
+                if (arc.to == excluded || state.is_contracted[arc.to]) {
+                    continue;
+                }
+
+                const Weight candidate_weight = weight + arc.weight;
+                if (!witness.IsReached(arc.to) || candidate_weight < witness.weights[arc.to]) {
+                    witness.Reach(arc.to, candidate_weight, arc.edge);
+                    witness.Push(candidate_weight, arc.to);
+                }
+            }
+        }
+    }
+
+    // Keeps the lightest of parallel arcs to every remaining neighbour
+    template <typename Weight>
+    std::vector<typename ContractionHierarchyRouter<Weight>::Arc> ContractionHierarchyRouter<Weight>::CollectLightestArcs(
+        const ContractionState& state, const std::vector<Arc>& arcs, VertexId vertex) const {
+        std::vector<Arc> lightest;
+        lightest.reserve(arcs.size());
+
+        for (const Arc& arc : arcs) {
+            if (arc.to != vertex && !state.is_contracted[arc.to]) {
+                lightest.push_back(arc);
+            }
+        }
+
+        std::sort(lightest.begin(), lightest.end(), [](const Arc& lhs, const Arc& rhs) {
+            return lhs.to != rhs.to ? lhs.to < rhs.to : lhs.weight < rhs.weight;
+        });
+
+        lightest.erase(std::unique(lightest.begin(), lightest.end(), [](const Arc& lhs, const Arc& rhs) {
+            return lhs.to == rhs.to;
+        }), lightest.end());
+
+        return lightest;
+    }
+
+//
+//
+//                                                                    + ---------------
+// -------------------------------------------------------------------- Search Graphs +
+
+    template <typename Weight>
+    void ContractionHierarchyRouter<Weight>::BuildSearchGraphs() {
+        upward_offsets_.assign(vertex_count_ + 1, 0);
+        downward_offsets_.assign(vertex_count_ + 1, 0);
+
+        for (const HierarchyEdge& edge : edges_) {
+            if (edge.from == edge.to) {
+                continue;
+            }
+
+            if (ranks_[edge.from] < ranks_[edge.to]) {
+                ++upward_offsets_[edge.from + 1];
+            }
+            else {
+                ++downward_offsets_[edge.to + 1];
+            }
+        }
+
+        for (std::size_t vertex = 0; vertex < vertex_count_; ++vertex) {
+            upward_offsets_[vertex + 1] += upward_offsets_[vertex];
+            downward_offsets_[vertex + 1] += downward_offsets_[vertex];
+        }
+
+        upward_arcs_.resize(upward_offsets_.back());
+        downward_arcs_.resize(downward_offsets_.back());
+
+        std::vector<std::size_t> upward_ends(upward_offsets_.begin(), upward_offsets_.end() - 1);
+        std::vector<std::size_t> downward_ends(downward_offsets_.begin(), downward_offsets_.end() - 1);
+
+        for (EdgeId edge_id = 0; edge_id < edges_.size(); ++edge_id) {
+            const HierarchyEdge& edge = edges_[edge_id];
+
+            if (edge.from == edge.to) {
+                continue;
+            }
+
+            if (ranks_[edge.from] < ranks_[edge.to]) {
+                upward_arcs_[upward_ends[edge.from]++] = Arc{ edge.to, edge.weight, edge_id };
+            }
+            else {
+                downward_arcs_[downward_ends[edge.to]++] = Arc{ edge.from, edge.weight, edge_id };
+            }
+        }
+    }
+
+//
+//
+//                                                                    + -------
+// -------------------------------------------------------------------- Query +
+
+    template <typename Weight>
+    std::pair<typename ContractionHierarchyRouter<Weight>::Workspace, typename ContractionHierarchyRouter<Weight>::Workspace>&
+        ContractionHierarchyRouter<Weight>::GetWorkspaces() {
+        thread_local std::pair<Workspace, Workspace> workspaces;
+        return workspaces;
+    }
+
+    template <typename Weight>
+    std::optional<typename ContractionHierarchyRouter<Weight>::RouteInfo> ContractionHierarchyRouter<Weight>::BuildRoute(
+        VertexId from, VertexId to) const {
+        if (from == to) {
+            return RouteInfo{ ZERO_WEIGHT, {} };
+        }
+
+        auto& [forward, backward] = GetWorkspaces();
+        forward.Prepare(vertex_count_);
+        backward.Prepare(vertex_count_);
+
+        forward.Reach(from, ZERO_WEIGHT, detail::NO_EDGE);
+        forward.Push(ZERO_WEIGHT, from);
+        backward.Reach(to, ZERO_WEIGHT, detail::NO_EDGE);
+        backward.Push(ZERO_WEIGHT, to);
+
+        std::optional<Weight> best_weight;
+        VertexId meeting_vertex = from;
+
+        while (!forward.queue.IsEmpty() || !backward.queue.IsEmpty()) {
+            const bool is_forward = backward.queue.IsEmpty()
+                || (!forward.queue.IsEmpty() && forward.queue.Top().first <= backward.queue.Top().first);
+
+            Workspace& current = is_forward ? forward : backward;
+            const Workspace& opposite = is_forward ? backward : forward;
+
+            if (best_weight && current.queue.Top().first >= *best_weight) {
+                current.queue.Clear();
+                continue;
+            }
+
+            const auto [weight, vertex] = current.Pop();
+            if (weight > current.weights[vertex]) {
+                continue;
+            }
+
+            if (opposite.IsReached(vertex) && (!best_weight || weight + opposite.weights[vertex] < *best_weight)) {
+                best_weight = weight + opposite.weights[vertex];
+                meeting_vertex = vertex;
+            }
+
+            const std::vector<std::size_t>& offsets = is_forward ? upward_offsets_ : downward_offsets_;
+            const std::vector<Arc>& arcs = is_forward ? upward_arcs_ : downward_arcs_;
+
+            for (std::size_t arc_index = offsets[vertex]; arc_index < offsets[vertex + 1]; ++arc_index) {
+                const Arc& arc = arcs[arc_index];
+                const Weight candidate_weight = weight + arc.weight;
+
+                if (!current.IsReached(arc.to) || candidate_weight < current.weights[arc.to]) {
+                    current.Reach(arc.to, candidate_weight, arc.edge);
+                    current.Push(candidate_weight, arc.to);
+                }
+            }
+        }
+
+        if (!best_weight) {
+            return std::nullopt;
+        }
+
+        std::vector<EdgeId> hierarchy_edges;
+        for (EdgeId edge_id = forward.prev_edges[meeting_vertex]; edge_id != detail::NO_EDGE;
+            edge_id = forward.prev_edges[edges_[edge_id].from])
+        {
+            hierarchy_edges.push_back(edge_id);
+        }
+
+        std::reverse(hierarchy_edges.begin(), hierarchy_edges.end());
+        for (EdgeId edge_id = backward.prev_edges[meeting_vertex]; edge_id != detail::NO_EDGE;
+            edge_id = backward.prev_edges[edges_[edge_id].to])
+        {
+            hierarchy_edges.push_back(edge_id);
+        }
+
+        std::vector<EdgeId> edges;
+        for (const EdgeId edge_id : hierarchy_edges) {
+            UnpackEdge(edge_id, edges);
+        }
+
+        return RouteInfo{ *best_weight, std::move(edges) };
+    }
+
+    template <typename Weight>
+    void ContractionHierarchyRouter<Weight>::UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& edges) const {
+        std::vector<EdgeId> to_unpack{ edge_id };
+
+        while (!to_unpack.empty()) {
+            const HierarchyEdge& edge = edges_[to_unpack.back()];
+            const EdgeId current_id = to_unpack.back();
+            to_unpack.pop_back();
+
+            if (edge.first == detail::NO_EDGE) {
+                edges.push_back(current_id);
+                continue;
+            }
+
+            to_unpack.push_back(edge.second);
+            to_unpack.push_back(edge.first);
+        }
+    }
+} // namespace graph
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+#include "graph.h"
+
+namespace graph {
+    // Frozen counterpart of DirectedWeightedGraph: the outgoing edges of every vertex are stored
+    // contiguously with their targets and weights, so engines scan them without extra lookups
+    template <typename Weight>
+    class CsrGraph {
+    public:
+        struct OutgoingEdge {
+            VertexId to;
+            Weight weight;
+            EdgeId id;
+        };
+
+        CsrGraph() = default;
+        explicit CsrGraph(const DirectedWeightedGraph<Weight>& graph);
+
+        // Freezes a graph of another weight type, e.g. to turn floating-point minutes into fixed-point time
+        template <typename SourceWeight, typename Converter>
+        CsrGraph(const DirectedWeightedGraph<SourceWeight>& graph, Converter convert);
+
+        size_t GetVertexCount() const;
+        size_t GetEdgeCount() const;
+        const Edge<Weight>& GetEdge(EdgeId edge_id) const;
+        std::span<const OutgoingEdge> GetOutgoingEdges(VertexId vertex) const;
+
+    private:
+        std::vector<Edge<Weight>> edges_;
+        std::vector<size_t> offsets_ = { 0 };
+        std::vector<OutgoingEdge> outgoing_edges_;
+    };
+
+    template <typename Weight>
+    CsrGraph<Weight>::CsrGraph(const DirectedWeightedGraph<Weight>& graph)
+        : CsrGraph(graph, [](Weight weight) { return weight; }) {
+    }
+
+    template <typename Weight>
+    template <typename SourceWeight, typename Converter>
+    CsrGraph<Weight>::CsrGraph(const DirectedWeightedGraph<SourceWeight>& graph, Converter convert)
+        : offsets_(graph.GetVertexCount() + 1) {
+        const size_t edge_count = graph.GetEdgeCount();
+        edges_.reserve(edge_count);
+
+        for (EdgeId edge_id = 0; edge_id < edge_count; ++edge_id) {
+            const Edge<SourceWeight>& edge = graph.GetEdge(edge_id);
+            edges_.push_back(Edge<Weight>{ edge.from, edge.to, convert(edge.weight) });
+            ++offsets_[edge.from + 1];
+        }
+
+        for (VertexId vertex = 0; vertex < graph.GetVertexCount(); ++vertex) {
+            offsets_[vertex + 1] += offsets_[vertex];
+        }
+
+        // Counting sort by source keeps the edges of every vertex in insertion order
+        std::vector<size_t> ends(offsets_.begin(), offsets_.end() - 1);
+        outgoing_edges_.resize(edge_count);
+
+        for (EdgeId edge_id = 0; edge_id < edge_count; ++edge_id) {
+            const Edge<Weight>& edge = edges_[edge_id];
+            outgoing_edges_[ends[edge.from]++] = OutgoingEdge{ edge.to, edge.weight, edge_id };
+        }
+    }
+
+    template <typename Weight>
+    size_t CsrGraph<Weight>::GetVertexCount() const {
+        return offsets_.size() - 1;
+    }
+
+    template <typename Weight>
+    size_t CsrGraph<Weight>::GetEdgeCount() const {
+        return edges_.size();
+    }
+
+    template <typename Weight>
+    const Edge<Weight>& CsrGraph<Weight>::GetEdge(EdgeId edge_id) const {
+        return edges_[edge_id];
+    }
+
+    template <typename Weight>
+    std::span<const typename CsrGraph<Weight>::OutgoingEdge> CsrGraph<Weight>::GetOutgoingEdges(VertexId vertex) const {
+        return { outgoing_edges_.data() + offsets_[vertex], outgoing_edges_.data() + offsets_[vertex + 1] };
+    }
+} // namespace graph
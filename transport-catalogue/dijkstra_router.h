@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "graph.h"
+#include "router.h"
+
+namespace graph {
+// ------------ [Dijkstra Router] Definition ------------
+//                                                      +
+//                                                      + ---------------
+// ------------------------------------------------------ Search Queues +
+
+    namespace detail {
+        inline constexpr EdgeId NO_EDGE = std::numeric_limits<EdgeId>::max();
+
+        // Binary min-heap, works for any weight type
+        template <typename Weight>
+        class BinaryHeap final {
+        public:
+            using Entry = std::pair<Weight, VertexId>;
+
+            bool IsEmpty() const;
+            void Clear();
+            void Push(Weight weight, VertexId vertex);
+            const Entry& Top();
+            Entry Pop();
+
+        private:
+            std::vector<Entry> entries_;
+        };
+
+        // Monotone radix heap for unsigned integer weights. Keys never go below the last extracted one,
+        // so an entry is moved to a lower bucket at most once per bit of its key
+        template <typename Weight>
+        class RadixHeap final {
+        public:
+            using Entry = std::pair<Weight, VertexId>;
+
+            bool IsEmpty() const;
+            void Clear();
+            void Push(Weight weight, VertexId vertex);
+            const Entry& Top();
+            Entry Pop();
+
+        private:
+            // Bucket [i] holds the keys whose highest bit differing from [last_] is bit i - 1
+            static std::size_t GetBucket(Weight weight, Weight last);
+            void Refill();
+
+            std::array<std::vector<Entry>, std::numeric_limits<Weight>::digits + 1> buckets_;
+            Weight last_ = 0;
+            std::size_t size_ = 0;
+        };
+
+        template <typename Weight>
+        using SearchQueue = std::conditional_t<std::is_unsigned_v<Weight>, RadixHeap<Weight>, BinaryHeap<Weight>>;
+
+// 
+// 
+//                                                      + ------------------
+// ------------------------------------------------------ Search Workspace +
+
+        // Labels of one Dijkstra-like search. A vertex label is valid only when its stamp matches
+        // the current epoch, which avoids clearing the arrays before every search
+        template <typename Weight>
+        struct SearchWorkspace final {
+            using QueueEntry = std::pair<Weight, VertexId>;
+
+            std::vector<Weight> weights;
+            std::vector<EdgeId> prev_edges;
+            std::vector<std::uint32_t> stamps;
+            std::uint32_t epoch = 0;
+            SearchQueue<Weight> queue;
+
+            void Prepare(std::size_t vertex_count);
+            bool IsReached(VertexId vertex) const;
+            void Reach(VertexId vertex, Weight weight, EdgeId prev_edge);
+
+            void Push(Weight weight, VertexId vertex);
+            QueueEntry Pop();
+        };
+    } // namespace detail
+
+// 
+// 
+//                                                      + -----------------
+// ------------------------------------------------------ Dijkstra Router +
+
+    // Point-to-point engine: no preprocessing, O(V + E) memory, one Dijkstra search per query.
+    // Searches reuse a per-thread workspace, so concurrent queries don't allocate once warmed up
+    template <typename Weight>
+    class DijkstraRouter final : public RoutingEngine<Weight> {
+    private:
+        using Graph = CsrGraph<Weight>;
+
+    public:
+        using typename RoutingEngine<Weight>::RouteInfo;
+
+        explicit DijkstraRouter(const Graph& graph);
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const override;
+
+    private:
+        using Workspace = detail::SearchWorkspace<Weight>;
+
+        static Workspace& GetWorkspace();
+
+        static constexpr Weight ZERO_WEIGHT{};
+        const Graph& graph_;
+    };
+
+// ------------ [Dijkstra Router] Realization ------------
+//                                                       +
+//                                                       + ---------------
+// ------------------------------------------------------- Search Queues +
+
+    namespace detail {
+        template <typename Weight>
+        bool BinaryHeap<Weight>::IsEmpty() const {
+            return entries_.empty();
+        }
+
+        template <typename Weight>
+        void BinaryHeap<Weight>::Clear() {
+            entries_.clear();
+        }
+
+        template <typename Weight>
+        void BinaryHeap<Weight>::Push(Weight weight, VertexId vertex) {
+            entries_.push_back({ weight, vertex });
+            std::push_heap(entries_.begin(), entries_.end(), std::greater<>{});
+        }
+
+        template <typename Weight>
+        const typename BinaryHeap<Weight>::Entry& BinaryHeap<Weight>::Top() {
+            return entries_.front();
+        }
+
+        template <typename Weight>
+        typename BinaryHeap<Weight>::Entry BinaryHeap<Weight>::Pop() {
+            std::pop_heap(entries_.begin(), entries_.end(), std::greater<>{});
+            const Entry entry = entries_.back();
+            entries_.pop_back();
+            return entry;
+        }
+
+        template <typename Weight>
+        bool RadixHeap<Weight>::IsEmpty() const {
+            return size_ == 0;
+        }
+
+        template <typename Weight>
+        void RadixHeap<Weight>::Clear() {
+            for (std::vector<Entry>& bucket : buckets_) {
+                bucket.clear();
+            }
+
+            last_ = 0;
+            size_ = 0;
+        }
+
+        template <typename Weight>
+        std::size_t RadixHeap<Weight>::GetBucket(Weight weight, Weight last) {
+            return static_cast<std::size_t>(std::bit_width(static_cast<Weight>(weight ^ last)));
+        }
+
+        template <typename Weight>
+        void RadixHeap<Weight>::Push(Weight weight, VertexId vertex) {
+            buckets_[GetBucket(weight, last_)].push_back({ weight, vertex });
+            ++size_;
+        }
+
+        // Moves the lowest non-empty bucket down, relative to its minimum, so that bucket 0 is not empty
+        template <typename Weight>
+        void RadixHeap<Weight>::Refill() {
+            if (!buckets_[0].empty()) {
+                return;
+            }
+
+            std::size_t bucket = 1;
+            while (buckets_[bucket].empty()) {
+                ++bucket;
+            }
+
+            last_ = std::min_element(buckets_[bucket].begin(), buckets_[bucket].end())->first;
+            for (const Entry& entry : buckets_[bucket]) {
+                buckets_[GetBucket(entry.first, last_)].push_back(entry);
+            }
+
+            buckets_[bucket].clear();
+        }
+
+        template <typename Weight>
+        const typename RadixHeap<Weight>::Entry& RadixHeap<Weight>::Top() {
+            Refill();
+            return buckets_[0].back();
+        }
+
+        template <typename Weight>
+        typename RadixHeap<Weight>::Entry RadixHeap<Weight>::Pop() {
+            Refill();
+            const Entry entry = buckets_[0].back();
+            buckets_[0].pop_back();
+            --size_;
+            return entry;
+        }
+
+// 
+// 
+//                                                       + ------------------
+// ------------------------------------------------------- Search Workspace +
+
+        template <typename Weight>
+        void SearchWorkspace<Weight>::Prepare(std::size_t vertex_count) {
+            if (weights.size() < vertex_count) {
+                weights.resize(vertex_count);
+                prev_edges.resize(vertex_count);
+                stamps.resize(vertex_count);
+            }
+
+            if (++epoch == 0) {
+                std::fill(stamps.begin(), stamps.end(), 0);
+                epoch = 1;
+            }
+
+            queue.Clear();
+        }
+
+        template <typename Weight>
+        bool SearchWorkspace<Weight>::IsReached(VertexId vertex) const {
+            return stamps[vertex] == epoch;
+        }
+
+        template <typename Weight>
+        void SearchWorkspace<Weight>::Reach(VertexId vertex, Weight weight, EdgeId prev_edge) {
+            weights[vertex] = weight;
+            prev_edges[vertex] = prev_edge;
+            stamps[vertex] = epoch;
+        }
+
+        template <typename Weight>
+        void SearchWorkspace<Weight>::Push(Weight weight, VertexId vertex) {
+            queue.Push(weight, vertex);
+        }
+
+        template <typename Weight>
+        typename SearchWorkspace<Weight>::QueueEntry SearchWorkspace<Weight>::Pop() {
+            return queue.Pop();
+        }
+    } // namespace detail
+
+    template <typename Weight>
+    typename DijkstraRouter<Weight>::Workspace& DijkstraRouter<Weight>::GetWorkspace() {
+        thread_local Workspace workspace;
+        return workspace;
+    }
+
+// 
+// 
+//                                                       + ----------------
+// ------------------------------------------------------- Dijkstra Router +
+
+    template <typename Weight>
+    DijkstraRouter<Weight>::DijkstraRouter(const Graph& graph)
+        : graph_(graph) {
+
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            if (graph.GetEdge(edge_id).weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+        }
+    }
+
+    template <typename Weight>
+    std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildRoute(VertexId from,
+        VertexId to) const {
+        Workspace& workspace = GetWorkspace();
+        workspace.Prepare(graph_.GetVertexCount());
+
+        workspace.Reach(from, ZERO_WEIGHT, detail::NO_EDGE);
+        workspace.Push(ZERO_WEIGHT, from);
+
+        while (!workspace.queue.IsEmpty()) {
+            const auto [weight, vertex] = workspace.Pop();
+
+            if (weight > workspace.weights[vertex]) {
+                continue;
+            }
+
+            if (vertex == to) {
+                break;
+            }
+
+            for (const auto& edge : graph_.GetOutgoingEdges(vertex)) {
+                const Weight candidate_weight = weight + edge.weight;
+
+                if (!workspace.IsReached(edge.to) || candidate_weight < workspace.weights[edge.to]) {
+                    workspace.Reach(edge.to, candidate_weight, edge.id);
+                    workspace.Push(candidate_weight, edge.to);
+                }
+            }
+        }
+
+        if (!workspace.IsReached(to)) {
+            return std::nullopt;
+        }
+
+        std::vector<EdgeId> edges;
+        for (EdgeId edge_id = workspace.prev_edges[to]; edge_id != detail::NO_EDGE;
+            edge_id = workspace.prev_edges[graph_.GetEdge(edge_id).from])
+        {
+            edges.push_back(edge_id);
+        }
+
+        std::reverse(edges.begin(), edges.end());
+        return RouteInfo{ workspace.weights[to], std::move(edges) };
+    }
+} // namespace graph
@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include "domain.h"
 
 namespace domain {
@@ -7,19 +9,19 @@ namespace domain {
 // ----------------------------------------------------- Stop & Bus structs +
 
 	bool Stop::operator==(std::string_view rhs) const {
-		return std::string_view(name) == rhs;
+		return name == rhs;
 	}
 
 	bool Stop::operator!=(std::string_view rhs) const {
-		return std::string_view(name) != rhs;
+		return name != rhs;
 	}
 
 	bool Bus::operator==(std::string_view rhs) const {
-		return std::string_view(name) == rhs;
+		return name == rhs;
 	}
 
 	bool Bus::operator!=(std::string_view rhs) const {
-		return std::string_view(name) != rhs;
+		return name != rhs;
 	}
 
 // 
@@ -27,13 +29,45 @@ namespace domain {
 //                                                      + -------------
 // ------------------------------------------------------ Auxiliaries +
 
-	bool Compartor::operator()(const Bus* lhs, const Bus* rhs) const {
-		return lhs->name < rhs->name;
+	std::size_t Hasher::operator()(const std::pair<StopId, StopId>& to_hash) const {
+		return id_hasher(static_cast<std::uint64_t>(to_hash.first) << 32 | to_hash.second);
+	}
+
+// 
+// 
+//                                                      + --------------------
+// ------------------------------------------------------ Catalogue Snapshot +
+
+	std::span<const StopId> Snapshot::GetBusStops(BusId bus) const {
+		return std::span<const StopId>(bus_stops).subspan(bus_stop_offsets[bus], bus_stop_offsets[bus + 1] - bus_stop_offsets[bus]);
+	}
+
+	std::span<const BusId> Snapshot::GetStopBuses(StopId stop) const {
+		return std::span<const BusId>(stop_buses).subspan(stop_bus_offsets[stop], stop_bus_offsets[stop + 1] - stop_bus_offsets[stop]);
+	}
+
+	geo::Coordinates Snapshot::GetCoordinates(StopId stop) const {
+		return { latitudes[stop], longitudes[stop] };
+	}
+
+	std::size_t Snapshot::GetStopCount() const {
+		return stop_names.size();
+	}
+
+	std::size_t Snapshot::GetBusCount() const {
+		return bus_names.size();
+	}
+
+// 
+// 
+//                                                      + ------------
+// ------------------------------------------------------ Route Data +
+
+	FixedTime ToFixedTime(double minutes) {
+		return static_cast<FixedTime>(std::llround(minutes * 60'000.0));
 	}
 
-	std::size_t Hasher::operator()(const std::pair<std::string_view, std::string_view>& to_hash) const {
-		std::size_t first = sw_hasher(to_hash.first);
-		std::size_t second = sw_hasher(to_hash.second);
-		return first + second * 37;
+	double ToMinutes(FixedTime time) {
+		return time / 60'000.0;
 	}
 } // namespace domain
\ No newline at end of file
@@ -1,14 +1,14 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <functional>
-#include <map>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "geo.h"
-#include "graph.h"
-#include "router.h"
 
 namespace domain {
 //------------ [Domain Structs] Definition ------------
@@ -16,18 +16,25 @@ namespace domain {
 //                                                     + --------------------
 // ----------------------------------------------------- Stop & Bus structs +
 
+	// Dense identifiers assigned by the catalogue in the order of addition
+	using StopId = std::uint32_t;
+	using BusId = std::uint32_t;
+
+	// Names refer to the storage of the catalogue
 	struct Stop final {
-		std::string name;
+		std::string_view name;
 		geo::Coordinates coordinates;
+		StopId id = {};
 
 		bool operator==(std::string_view rhs) const;
 		bool operator!=(std::string_view rhs) const;
 	};
 
 	struct Bus final {
-		std::string name;
+		std::string_view name;
 		std::vector<Stop*> stops_with_duplicates;
 		bool is_roundtrip = {};
+		BusId id = {};
 
 		bool operator==(std::string_view rhs) const;
 		bool operator!=(std::string_view rhs) const;
@@ -38,16 +45,11 @@ namespace domain {
 //                                                     + -------------
 // ----------------------------------------------------- Auxiliaries +
 
-	struct Compartor final {
-		using is_transparent = std::false_type;
-		bool operator()(const Bus* lhs, const Bus* rhs) const;
-	};
-
 	struct Hasher final {
-		std::size_t operator()(const std::pair<std::string_view, std::string_view>& to_hash) const;
+		std::size_t operator()(const std::pair<StopId, StopId>& to_hash) const;
 
 	private:
-		std::hash<std::string_view> sw_hasher;
+		std::hash<std::uint64_t> id_hasher;
 	};
 
 // 
@@ -73,27 +75,85 @@ namespace domain {
 		double curvature = 0.0;
 	};
 
+// 
+// 
+//                                                     + -------------------
+// ----------------------------------------------------- Catalogue Snapshot +
+
+	// Read-only struct-of-arrays view of a frozen catalogue. Names refer to the catalogue's storage
+	struct Snapshot final {
+		std::span<const StopId> GetBusStops(BusId bus) const;
+		std::span<const BusId> GetStopBuses(StopId stop) const;
+		geo::Coordinates GetCoordinates(StopId stop) const;
+
+		std::size_t GetStopCount() const;
+		std::size_t GetBusCount() const;
+
+		std::vector<std::string_view> stop_names;
+		std::vector<double> latitudes;
+		std::vector<double> longitudes;
+
+		// Stops of bus [id] (with duplicates): [bus_stop_offsets[id], bus_stop_offsets[id + 1]) of bus_stops
+		std::vector<std::string_view> bus_names;
+		std::vector<std::uint8_t> are_roundtrips;
+		std::vector<std::uint32_t> bus_stop_offsets;
+		std::vector<StopId> bus_stops;
+
+		// Buses passing through stop [id], sorted by name: [stop_bus_offsets[id], stop_bus_offsets[id + 1]) of stop_buses
+		std::vector<std::uint32_t> stop_bus_offsets;
+		std::vector<BusId> stop_buses;
+	};
+
 // 
 // 
 //                                                     + ------------
 // ----------------------------------------------------- Route Data +
 
+	enum class RouterEngine {
+		FLOYD_WARSHALL,
+		BLOCKED_FLOYD_WARSHALL,
+		DIJKSTRA,
+		CONTRACTION_HIERARCHY,
+		RAPTOR,
+		DIJKSTRA_FIXED_POINT,
+		A_STAR,
+		ALT,
+		ROW_CACHE,
+		COMPACT_FLOYD_WARSHALL
+	};
+
 	struct RoutingSettings final {
 		std::uint16_t bus_wait_time = {};
 		double bus_velocity = {};
+		RouterEngine engine = RouterEngine::FLOYD_WARSHALL;
+
+		// Memory of the cached single-source rows, in bytes
+		std::size_t row_cache_budget = std::size_t{ 64 } << 20;
 	};
 
-	struct Data final {
-		std::optional<typename graph::Router<double>::RouteInfo> route;
-		const graph::DirectedWeightedGraph<double>& graph;
-		const graph::Router<double>* router;
-		std::uint16_t bus_wait_time;
-		const std::deque<domain::Stop>& graph_stops;
-		const std::unordered_map<std::pair<std::string_view, std::string_view>, std::map<std::size_t, std::deque<std::string_view>>, domain::Hasher>& spans;
+	// Fixed-point route time for the integer-weight engines, in milliseconds: 32 bits cover 49 days
+	using FixedTime = std::uint32_t;
+
+	FixedTime ToFixedTime(double minutes);
+	double ToMinutes(FixedTime time);
+
+	// One leg of an optimal route: wait at [stop] or ride [bus] through [span_count] stops
+	struct RouteItem final {
+		enum class Type {
+			WAIT,
+			BUS
+		};
+
+		Type type = Type::WAIT;
+		StopId stop = {};
+		BusId bus = {};
+		std::size_t span_count = {};
+		double time = {};
 	};
 
-	struct SpanInfo final {
-		std::size_t span_count;
-		const std::deque<std::string_view>* buses = nullptr;
+	// Engine-independent answer to a route request
+	struct Route final {
+		double total_time = {};
+		std::vector<RouteItem> items;
 	};
 } // namespace domain
\ No newline at end of file
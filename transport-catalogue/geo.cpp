@@ -1,7 +1,12 @@
 #define _USE_MATH_DEFINES
 
+#include <algorithm>
 #include <cmath>
 
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
 #include "geo.h"
 
 namespace geo {
@@ -10,11 +15,97 @@ namespace geo {
 //                                                 + -----------
 // ------------------------------------------------- Geography +
 
+    namespace {
+        const double EARTH_RADIUS = 6371000;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        // Masked form of _mm256_i32gather_pd(): GCC warns about the undefined source of the unmasked one
+        __m256d Gather(const double* values, __m128i indices) {
+            const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), values, indices, all_lanes, 8);
+        }
+#endif
+    }
+
     double ComputeDistance(Coordinates from, Coordinates to) {
         using namespace std;
         const double dr = M_PI / 180.0;
         return acos(sin(from.lat * dr) * sin(to.lat * dr)
             + cos(from.lat * dr) * cos(to.lat * dr) * cos(abs(from.lng - to.lng) * dr))
-            * 6371000;
+            * EARTH_RADIUS;
+    }
+
+// 
+// 
+//                                                 + ----------------------
+// ------------------------------------------------- Batch of Coordinates +
+
+    PointsTrigonometry ComputeTrigonometry(std::span<const double> latitudes, std::span<const double> longitudes) {
+        const double dr = M_PI / 180.0;
+        PointsTrigonometry points;
+
+        points.sin_lat.reserve(latitudes.size());
+        points.cos_lat.reserve(latitudes.size());
+        points.sin_lng.reserve(longitudes.size());
+        points.cos_lng.reserve(longitudes.size());
+
+        for (std::size_t i = 0; i < latitudes.size(); ++i) {
+            points.sin_lat.push_back(std::sin(latitudes[i] * dr));
+            points.cos_lat.push_back(std::cos(latitudes[i] * dr));
+            points.sin_lng.push_back(std::sin(longitudes[i] * dr));
+            points.cos_lng.push_back(std::cos(longitudes[i] * dr));
+        }
+
+        return points;
+    }
+
+    double ComputeDistance(const PointsTrigonometry& points, std::uint32_t from, std::uint32_t to) {
+        const double cos_lng = points.cos_lng[from] * points.cos_lng[to] + points.sin_lng[from] * points.sin_lng[to];
+        const double cosine = points.sin_lat[from] * points.sin_lat[to] + points.cos_lat[from] * points.cos_lat[to] * cos_lng;
+        return std::acos(std::min(cosine, 1.0)) * EARTH_RADIUS;
+    }
+
+    double ComputePolylineLength(const PointsTrigonometry& points, std::span<const std::uint32_t> polyline) {
+        if (polyline.size() < 2) {
+            return 0.0;
+        }
+
+        const std::size_t segment_count = polyline.size() - 1;
+        double angle_sum = 0.0;
+        std::size_t segment = 0;
+
+#if defined(__AVX2__) && defined(__FMA__)
+        alignas(32) double cosines[4];
+        const __m256d one = _mm256_set1_pd(1.0);
+
+        for (; segment + 4 <= segment_count; segment += 4) {
+            const __m128i from = _mm_loadu_si128(reinterpret_cast<const __m128i*>(polyline.data() + segment));
+            const __m128i to = _mm_loadu_si128(reinterpret_cast<const __m128i*>(polyline.data() + segment + 1));
+
+            const __m256d cos_lng = _mm256_fmadd_pd(
+                Gather(points.cos_lng.data(), from), Gather(points.cos_lng.data(), to),
+                _mm256_mul_pd(Gather(points.sin_lng.data(), from), Gather(points.sin_lng.data(), to)));
+
+            const __m256d cos_lat = _mm256_mul_pd(
+                Gather(points.cos_lat.data(), from), Gather(points.cos_lat.data(), to));
+
+            const __m256d cosine = _mm256_fmadd_pd(cos_lat, cos_lng, _mm256_mul_pd(
+                Gather(points.sin_lat.data(), from), Gather(points.sin_lat.data(), to)));
+
+            _mm256_store_pd(cosines, _mm256_min_pd(cosine, one));
+            angle_sum += std::acos(cosines[0]) + std::acos(cosines[1]) + std::acos(cosines[2]) + std::acos(cosines[3]);
+        }
+#endif
+
+        for (; segment < segment_count; ++segment) {
+            const std::uint32_t from = polyline[segment];
+            const std::uint32_t to = polyline[segment + 1];
+
+            const double cos_lng = points.cos_lng[from] * points.cos_lng[to] + points.sin_lng[from] * points.sin_lng[to];
+            const double cosine = points.sin_lat[from] * points.sin_lat[to] + points.cos_lat[from] * points.cos_lat[to] * cos_lng;
+            angle_sum += std::acos(std::min(cosine, 1.0));
+        }
+
+        return angle_sum * EARTH_RADIUS;
     }
-} // namespace geo
\ No newline at end of file
+} // namespace geo
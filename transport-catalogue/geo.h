@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
+#include <vector>
+
 namespace geo {
 // ------------ [Geography] Definition ------------
 //                                                +
@@ -20,4 +24,29 @@ namespace geo {
     };
 
     double ComputeDistance(Coordinates from, Coordinates to);
-} // namespace geo
\ No newline at end of file
+
+// 
+// 
+//                                                + ----------------------
+// ------------------------------------------------ Batch of Coordinates +
+
+    // Per-point terms of ComputeDistance(), evaluated once for every point
+    struct PointsTrigonometry final {
+        std::vector<double> sin_lat;
+        std::vector<double> cos_lat;
+        std::vector<double> sin_lng;
+        std::vector<double> cos_lng;
+    };
+
+    PointsTrigonometry ComputeTrigonometry(std::span<const double> latitudes, std::span<const double> longitudes);
+
+    // ComputeDistance() between two points of [points], with the same tolerance as ComputePolylineLength()
+    double ComputeDistance(const PointsTrigonometry& points, std::uint32_t from, std::uint32_t to);
+
+    // Sum of ComputeDistance() between consecutive points of [polyline] (indices into [points]).
+    // cos(lng1 - lng2) is expanded into per-point terms, so the only per-segment transcendental call is acos().
+    // Uses AVX2 when geo.cpp is compiled with -mavx2 -mfma (or an -march that implies both), scalar code otherwise.
+    // Tolerance against ComputeDistance(): below 1e-4 m per segment longer than 100 m and below 0.1 m
+    // for (nearly) coincident points, where acos() is ill-conditioned (ComputeDistance() may even return NaN there)
+    double ComputePolylineLength(const PointsTrigonometry& points, std::span<const std::uint32_t> polyline);
+} // namespace geo
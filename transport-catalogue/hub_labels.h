@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "csr_graph.h"
+#include "dijkstra_router.h"
+#include "graph.h"
+
+namespace graph {
+// ------------ [Hub Labels] Definition ------------
+//                                                 +
+//                                                 + ------------
+// ------------------------------------------------- Hub Labels +
+
+    // Distance-only index: every vertex keeps the weights to (out label) and from (in label) a few hubs,
+    // so that some common hub lies on a shortest path of every reachable pair. A query is a merge of
+    // two labels sorted by hub rank. Labels are built by pruned Dijkstra searches, hubs by decreasing degree
+    template <typename Weight>
+    class HubLabels final {
+    private:
+        using Graph = CsrGraph<Weight>;
+
+    public:
+        explicit HubLabels(const Graph& graph);
+
+        std::optional<Weight> ComputeWeight(VertexId from, VertexId to) const;
+
+        std::size_t GetEntryCount() const;
+        std::size_t GetMemoryUsage() const;
+
+    private:
+        struct LabelEntry final {
+            std::uint32_t hub;
+            Weight weight;
+        };
+
+        // Labels of vertex [v]: [offsets[v], offsets[v + 1]) of hubs and weights, stored apart so the merge scans hubs only
+        struct Labels final {
+            std::vector<std::size_t> offsets;
+            std::vector<std::uint32_t> hubs;
+            std::vector<Weight> weights;
+
+            void Assign(const std::vector<std::vector<LabelEntry>>& labels);
+            std::size_t GetMemoryUsage() const;
+        };
+
+        template <typename ForEachArc>
+        static void SearchFromHub(std::uint32_t rank, VertexId hub, const std::vector<std::vector<LabelEntry>>& hub_labels,
+            std::vector<std::vector<LabelEntry>>& labels, std::vector<Weight>& hub_weights, detail::SearchWorkspace<Weight>& search,
+            ForEachArc for_each_arc);
+
+        static constexpr Weight ZERO_WEIGHT{};
+        static constexpr Weight UNREACHABLE = std::numeric_limits<Weight>::max();
+
+        Labels out_labels_;
+        Labels in_labels_;
+    };
+
+// ------------ [Hub Labels] Realization ------------
+//                                                  +
+//                                                  + --------------
+// -------------------------------------------------- Building labels +
+
+    template <typename Weight>
+    HubLabels<Weight>::HubLabels(const Graph& graph) {
+        const std::size_t vertex_count = graph.GetVertexCount();
+
+        std::vector<std::size_t> reverse_offsets(vertex_count + 1);
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            const auto& edge = graph.GetEdge(edge_id);
+
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+
+            ++reverse_offsets[edge.to + 1];
+        }
+
+        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+            reverse_offsets[vertex + 1] += reverse_offsets[vertex];
+        }
+
+        std::vector<LabelEntry> reverse_arcs(graph.GetEdgeCount());
+        std::vector<std::size_t> reverse_ends(reverse_offsets.begin(), reverse_offsets.end() - 1);
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            const auto& edge = graph.GetEdge(edge_id);
+            reverse_arcs[reverse_ends[edge.to]++] = LabelEntry{ static_cast<std::uint32_t>(edge.from), edge.weight };
+        }
+
+        auto for_each_outgoing = [&graph](VertexId vertex, auto relax) {
+            for (const auto& edge : graph.GetOutgoingEdges(vertex)) {
+                relax(edge.to, edge.weight);
+            }
+        };
+
+        auto for_each_incoming = [&reverse_offsets, &reverse_arcs](VertexId vertex, auto relax) {
+            for (std::size_t arc = reverse_offsets[vertex]; arc < reverse_offsets[vertex + 1]; ++arc) {
+                relax(reverse_arcs[arc].hub, reverse_arcs[arc].weight);
+            }
+        };
+
+        // Well-connected vertices cover most shortest paths, so they become hubs first
+        std::vector<VertexId> order(vertex_count);
+        std::iota(order.begin(), order.end(), VertexId{});
+        std::stable_sort(order.begin(), order.end(), [&](VertexId lhs, VertexId rhs) {
+            const std::size_t lhs_degree = graph.GetOutgoingEdges(lhs).size() + reverse_offsets[lhs + 1] - reverse_offsets[lhs];
+            const std::size_t rhs_degree = graph.GetOutgoingEdges(rhs).size() + reverse_offsets[rhs + 1] - reverse_offsets[rhs];
+            return lhs_degree > rhs_degree;
+        });
+
+        std::vector<std::vector<LabelEntry>> out_labels(vertex_count);
+        std::vector<std::vector<LabelEntry>> in_labels(vertex_count);
+        std::vector<Weight> hub_weights(vertex_count, UNREACHABLE);
+        detail::SearchWorkspace<Weight> search;
+
+        for (std::uint32_t rank = 0; rank < vertex_count; ++rank) {
+            const VertexId hub = order[rank];
+
+            // Forward search fills the in labels of the vertices the hub reaches, backward one the out labels
+            SearchFromHub(rank, hub, out_labels, in_labels, hub_weights, search, for_each_outgoing);
+            SearchFromHub(rank, hub, in_labels, out_labels, hub_weights, search, for_each_incoming);
+        }
+
+        out_labels_.Assign(out_labels);
+        in_labels_.Assign(in_labels);
+    }
+
+    // A vertex whose weight is already covered by the labels of higher-ranked hubs is neither labelled nor expanded
+    template <typename Weight>
+    template <typename ForEachArc>
+    void HubLabels<Weight>::SearchFromHub(std::uint32_t rank, VertexId hub, const std::vector<std::vector<LabelEntry>>& hub_labels,
+        std::vector<std::vector<LabelEntry>>& labels, std::vector<Weight>& hub_weights, detail::SearchWorkspace<Weight>& search,
+        ForEachArc for_each_arc) {
+
+        for (const LabelEntry& entry : hub_labels[hub]) {
+            hub_weights[entry.hub] = entry.weight;
+        }
+
+        search.Prepare(labels.size());
+        search.Reach(hub, ZERO_WEIGHT, detail::NO_EDGE);
+        search.Push(ZERO_WEIGHT, hub);
+
+        while (!search.queue.IsEmpty()) {
+            const auto [weight, vertex] = search.Pop();
+
+            if (weight > search.weights[vertex]) {
+                continue;
+            }
+
+            const bool is_covered = std::any_of(labels[vertex].begin(), labels[vertex].end(), [&](const LabelEntry& entry) {
+                return hub_weights[entry.hub] != UNREACHABLE && !(weight < hub_weights[entry.hub] + entry.weight);
+            });
+
+            if (is_covered) {
+                continue;
+            }
+
+            labels[vertex].push_back(LabelEntry{ rank, weight });
+
+            for_each_arc(vertex, [&search, weight](VertexId next, Weight arc_weight) {
+                const Weight candidate_weight = weight + arc_weight;
+
+                if (!search.IsReached(next) || candidate_weight < search.weights[next]) {
+                    search.Reach(next, candidate_weight, detail::NO_EDGE);
+                    search.Push(candidate_weight, next);
+                }
+            });
+        }
+
+        for (const LabelEntry& entry : hub_labels[hub]) {
+            hub_weights[entry.hub] = UNREACHABLE;
+        }
+    }
+
+    template <typename Weight>
+    void HubLabels<Weight>::Labels::Assign(const std::vector<std::vector<LabelEntry>>& labels) {
+        offsets.assign(1, 0);
+        hubs.clear();
+        weights.clear();
+
+        for (const std::vector<LabelEntry>& label : labels) {
+            for (const LabelEntry& entry : label) {
+                hubs.push_back(entry.hub);
+                weights.push_back(entry.weight);
+            }
+
+            offsets.push_back(hubs.size());
+        }
+
+        offsets.shrink_to_fit();
+        hubs.shrink_to_fit();
+        weights.shrink_to_fit();
+    }
+
+//
+//
+//                                                  + ----------
+// -------------------------------------------------- Queries +
+
+    template <typename Weight>
+    std::optional<Weight> HubLabels<Weight>::ComputeWeight(VertexId from, VertexId to) const {
+        if (from == to) {
+            return ZERO_WEIGHT;
+        }
+
+        std::size_t out_index = out_labels_.offsets[from];
+        const std::size_t out_end = out_labels_.offsets[from + 1];
+        std::size_t in_index = in_labels_.offsets[to];
+        const std::size_t in_end = in_labels_.offsets[to + 1];
+
+        std::optional<Weight> best;
+        while (out_index < out_end && in_index < in_end) {
+            const std::uint32_t out_hub = out_labels_.hubs[out_index];
+            const std::uint32_t in_hub = in_labels_.hubs[in_index];
+
+            if (out_hub < in_hub) {
+                ++out_index;
+            }
+            else if (in_hub < out_hub) {
+                ++in_index;
+            }
+            else {
+                const Weight weight = out_labels_.weights[out_index++] + in_labels_.weights[in_index++];
+
+                if (!best || weight < *best) {
+                    best = weight;
+                }
+            }
+        }
+
+        return best;
+    }
+
+    template <typename Weight>
+    std::size_t HubLabels<Weight>::GetEntryCount() const {
+        return out_labels_.hubs.size() + in_labels_.hubs.size();
+    }
+
+    template <typename Weight>
+    std::size_t HubLabels<Weight>::GetMemoryUsage() const {
+        return out_labels_.GetMemoryUsage() + in_labels_.GetMemoryUsage();
+    }
+
+    template <typename Weight>
+    std::size_t HubLabels<Weight>::Labels::GetMemoryUsage() const {
+        return offsets.size() * sizeof(std::size_t) + hubs.size() * sizeof(std::uint32_t) + weights.size() * sizeof(Weight);
+    }
+} // namespace graph
@@ -1,3 +1,16 @@
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <optional>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "json.h"
 
 namespace json {
@@ -11,6 +24,77 @@ namespace json {
     namespace {
         Node LoadNode(std::istream& input);
 
+        // Objects are collected unordered and sorted once, so loading an object of n keys takes O(n log n)
+        Dict MakeDict(Dict::Entries entries) {
+            std::sort(entries.begin(), entries.end(), [](const Dict::Entry& lhs, const Dict::Entry& rhs) {
+                return lhs.first < rhs.first;
+            });
+
+            const auto duplicate = std::adjacent_find(entries.begin(), entries.end(), [](const Dict::Entry& lhs, const Dict::Entry& rhs) {
+                return lhs.first == rhs.first;
+            });
+
+            if (duplicate != entries.end()) {
+                throw ParsingError("Parsing Error [Dict]. Duplicate key '"s + std::string(duplicate->first) + "' has been spotted.");
+            }
+
+            return Dict(std::move(entries));
+        }
+
+        void AppendUtf8(std::string& line, std::uint32_t code_point) {
+            if (code_point < 0x80) {
+                line.push_back(static_cast<char>(code_point));
+            }
+            else if (code_point < 0x800) {
+                line.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+                line.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+            else if (code_point < 0x10000) {
+                line.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+                line.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                line.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+            else {
+                line.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+                line.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+                line.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                line.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+        }
+
+        // \u escapes of both loaders: [high] is the escaped code unit, [load_low] reads the one escaped
+        // right after it, if any. Surrogates are valid only as a high one followed by a low one
+        template <typename LoadLowSurrogate>
+        std::uint32_t JoinSurrogates(std::uint32_t high, LoadLowSurrogate load_low) {
+            if (high >= 0xDC00 && high <= 0xDFFF) {
+                throw ParsingError("Parsing Error [string]. Unpaired low surrogate.");
+            }
+
+            if (high < 0xD800 || high > 0xDBFF) {
+                return high;
+            }
+
+            const std::optional<std::uint32_t> low = load_low();
+
+            if (!low.has_value() || *low < 0xDC00 || *low > 0xDFFF) {
+                throw ParsingError("Parsing Error [string]. Unpaired high surrogate.");
+            }
+
+            return 0x10000 + ((high - 0xD800) << 10) + (*low - 0xDC00);
+        }
+
+        std::uint32_t ParseHexQuad(const char* begin, const char* end) {
+            std::uint32_t value = 0;
+            const char* last = end - begin < 4 ? end : begin + 4;
+            const auto [parsed_last, error] = std::from_chars(begin, last, value, 16);
+
+            if (error != std::errc{} || parsed_last != begin + 4) {
+                throw ParsingError("Parsing Error [string]. Invalid \\u escape.");
+            }
+
+            return value;
+        }
+
     // ------------ [Loaders] Realization ------------
     //                                               +
     //                                               + --------------------
@@ -146,6 +230,31 @@ namespace json {
     //                                               + ---------------
     // ----------------------------------------------- String Loader +
 
+        std::uint32_t LoadHexQuad(std::istream& input) {
+            char digits[4] = {};
+            input.read(digits, 4);
+
+            return ParseHexQuad(digits, digits + input.gcount());
+        }
+
+        std::uint32_t LoadCodePoint(std::istream& input) {
+            return JoinSurrogates(LoadHexQuad(input), [&input]() -> std::optional<std::uint32_t> {
+                if (input.peek() != '\\') {
+                    return std::nullopt;
+                }
+
+                input.get();
+                if (input.peek() != 'u') {
+                    input.putback('\\');
+                    return std::nullopt;
+                }
+
+                input.get();
+                return LoadHexQuad(input);
+            });
+        }
+
+        // Escapes are decoded the same way as by the buffer loaders
         Node LoadString(std::istream& input) {
             std::string line;
 
@@ -183,6 +292,26 @@ namespace json {
                         input.get();
                         break;
 
+                    case 'b':
+                        line.push_back('\b');
+                        input.get();
+                        break;
+
+                    case 'f':
+                        line.push_back('\f');
+                        input.get();
+                        break;
+
+                    case '/':
+                        line.push_back('/');
+                        input.get();
+                        break;
+
+                    case 'u':
+                        input.get();
+                        AppendUtf8(line, LoadCodePoint(input));
+                        break;
+
                     default:
                         line.push_back(ch);
                     }
@@ -252,18 +381,14 @@ namespace json {
     // ----------------------------------------------- Dictionary Loader +
 
         Node LoadDict(std::istream& input) {
-            Dict result;
+            Dict::Entries entries;
 
             for (char ch; input >> ch && ch != '}';) {
                 if (ch == '"') {
-                    std::string key = LoadString(input).AsString();
+                    std::pmr::string key(LoadString(input).AsString());
 
                     if (input >> ch && ch == ':') {
-                        if (result.find(key) != result.end()) {
-                            throw ParsingError("Parsing Error [Dict]. Duplicate key '"s + key + "' has been spotted.");
-                        }
-
-                        result.emplace(std::move(key), LoadNode(input));
+                        entries.emplace_back(std::move(key), LoadNode(input));
                     }
                     else {
                         throw ParsingError("Parsing Error [Dict]. Sign \":\" was expected but '"s + ch + "' has been spotted."s);
@@ -278,7 +403,7 @@ namespace json {
                 throw ParsingError("Parsing Error [Dict]."s);
             }
 
-            return Node(std::move(result));
+            return Node(MakeDict(std::move(entries)));
         }
 
     // 
@@ -314,6 +439,559 @@ namespace json {
 
             throw ParsingError("Parsing Error [char]. Invalid type has been spotted.");
         }
+
+    // ------------ [Buffer Loaders] Realization ------------
+    //                                                      +
+    //                                                      + -----------
+    // ------------------------------------------------------ Scanning +
+
+        // Contiguous input parsed in place: the loaders below move [position] towards [end].
+        // A borrowing buffer makes string values without escapes refer to the input and copies
+        // the escaped ones into [resource], which also backs the containers
+        struct Buffer final {
+            const char* position;
+            const char* end;
+            bool is_borrowing = false;
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+
+            // Children of the open containers. A container is moved out at its final size,
+            // so growth never leaves abandoned blocks in a monotonic [resource]
+            std::vector<Node> nodes{};
+            std::vector<Dict::Entry> entries{};
+
+            bool IsEnd() const {
+                return position == end;
+            }
+
+            Array TakeNodes(std::size_t first) {
+                Array result(resource);
+                result.reserve(nodes.size() - first);
+                std::move(nodes.begin() + first, nodes.end(), std::back_inserter(result));
+                nodes.resize(first);
+                return result;
+            }
+
+            Dict::Entries TakeEntries(std::size_t first) {
+                Dict::Entries result(resource);
+                result.reserve(entries.size() - first);
+                std::move(entries.begin() + first, entries.end(), std::back_inserter(result));
+                entries.resize(first);
+                return result;
+            }
+        };
+
+        Node LoadNode(Buffer& buffer);
+
+        bool IsSpace(char ch) {
+            return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+        }
+
+        // Indentation of pretty-printed input is skipped 16 bytes at a time
+        void SkipSpaces(Buffer& buffer) {
+#if defined(__SSE2__)
+            while (buffer.end - buffer.position >= 16 && IsSpace(*buffer.position)) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer.position));
+                const __m128i spaces = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))));
+                const std::uint32_t others = ~static_cast<std::uint32_t>(_mm_movemask_epi8(spaces)) & 0xFFFF;
+
+                if (others != 0) {
+                    buffer.position += std::countr_zero(others);
+                    return;
+                }
+
+                buffer.position += 16;
+            }
+#endif
+            while (!buffer.IsEnd() && IsSpace(*buffer.position)) {
+                ++buffer.position;
+            }
+        }
+
+        // The first quote or backslash of [position, end), the only characters that stop a string
+        const char* FindStringStop(const char* position, const char* end) {
+#if defined(__SSE2__)
+            const __m128i quotes = _mm_set1_epi8('"');
+            const __m128i backslashes = _mm_set1_epi8('\\');
+
+            for (; end - position >= 16; position += 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+                const std::uint32_t stops = static_cast<std::uint32_t>(_mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes), _mm_cmpeq_epi8(chunk, backslashes))));
+
+                if (stops != 0) {
+                    return position + std::countr_zero(stops);
+                }
+            }
+#endif
+            while (position != end && *position != '"' && *position != '\\') {
+                ++position;
+            }
+
+            return position;
+        }
+
+        bool IsNumberChar(char ch) {
+            return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E';
+        }
+
+    // 
+    // 
+    //                                                      + ---------------------
+    // ------------------------------------------------------ Int & Double Loader +
+
+        // Integers out of the int range are kept as doubles
+        Node LoadIntAndDouble(Buffer& buffer) {
+            const char* begin = buffer.position;
+            bool is_integer = true;
+
+            while (!buffer.IsEnd() && IsNumberChar(*buffer.position)) {
+                is_integer = is_integer && *buffer.position != '.' && *buffer.position != 'e' && *buffer.position != 'E';
+                ++buffer.position;
+            }
+
+            if (is_integer) {
+                int value = 0;
+                const auto [last, error] = std::from_chars(begin, buffer.position, value);
+
+                if (error == std::errc{} && last == buffer.position) {
+                    return Node(value);
+                }
+                if (error != std::errc::result_out_of_range) {
+                    throw ParsingError("Parsing Error [int, double]. Invalid number.");
+                }
+            }
+
+            double value = 0.0;
+            const auto [last, error] = std::from_chars(begin, buffer.position, value);
+
+            if (error != std::errc{} || last != buffer.position) {
+                throw ParsingError("Parsing Error [int, double]. Invalid number.");
+            }
+
+            return Node(value);
+        }
+
+    // 
+    // 
+    //                                                      + --------------------------
+    // ------------------------------------------------------ Boolean & Nullptr_t Loader +
+
+        // A literal must not run into the next token, like "nullx" or "true1"
+        void SkipLiteral(Buffer& buffer, std::string_view literal, const char* error) {
+            if (static_cast<std::size_t>(buffer.end - buffer.position) < literal.size()
+                || std::string_view(buffer.position, literal.size()) != literal) {
+                throw ParsingError(error);
+            }
+
+            buffer.position += literal.size();
+
+            if (!buffer.IsEnd() && (std::isalnum(static_cast<unsigned char>(*buffer.position)) || *buffer.position == '_')) {
+                throw ParsingError(error);
+            }
+        }
+
+        Node LoadBool(Buffer& buffer) {
+            if (*buffer.position == 't') {
+                SkipLiteral(buffer, "true"sv, "Parsing Error [boolean].");
+                return Node{ true };
+            }
+
+            SkipLiteral(buffer, "false"sv, "Parsing Error [boolean].");
+            return Node{ false };
+        }
+
+        Node LoadNull(Buffer& buffer) {
+            SkipLiteral(buffer, "null"sv, "Parsing Error [null].");
+            return Node{ nullptr };
+        }
+
+    // 
+    // 
+    //                                                      + ---------------
+    // ------------------------------------------------------ String Loader +
+
+        std::uint32_t LoadHexQuad(Buffer& buffer) {
+            const std::uint32_t value = ParseHexQuad(buffer.position, buffer.end);
+            buffer.position += 4;
+            return value;
+        }
+
+        std::uint32_t LoadCodePoint(Buffer& buffer) {
+            return JoinSurrogates(LoadHexQuad(buffer), [&buffer]() -> std::optional<std::uint32_t> {
+                if (buffer.end - buffer.position < 2 || buffer.position[0] != '\\' || buffer.position[1] != 'u') {
+                    return std::nullopt;
+                }
+
+                buffer.position += 2;
+                return LoadHexQuad(buffer);
+            });
+        }
+
+        // Called past the opening quote. Runs without escapes are appended at once
+        std::string LoadStringContent(Buffer& buffer) {
+            std::string line;
+
+            while (true) {
+                const char* stop = FindStringStop(buffer.position, buffer.end);
+                line.append(buffer.position, stop);
+                buffer.position = stop;
+
+                if (buffer.IsEnd()) {
+                    throw ParsingError("Parsing Error [string].");
+                }
+
+                if (*buffer.position++ == '"') {
+                    return line;
+                }
+
+                if (buffer.IsEnd()) {
+                    throw ParsingError("Parsing Error [string].");
+                }
+
+                switch (const char escaped = *buffer.position++; escaped) {
+                case 'n':
+                    line.push_back('\n');
+                    break;
+
+                case 'r':
+                    line.push_back('\r');
+                    break;
+
+                case 't':
+                    line.push_back('\t');
+                    break;
+
+                case 'b':
+                    line.push_back('\b');
+                    break;
+
+                case 'f':
+                    line.push_back('\f');
+                    break;
+
+                case '"':
+                case '\\':
+                case '/':
+                    line.push_back(escaped);
+                    break;
+
+                case 'u':
+                    AppendUtf8(line, LoadCodePoint(buffer));
+                    break;
+
+                // Unknown escapes are kept as they are, like the stream loader does
+                default:
+                    line.push_back('\\');
+                    --buffer.position;
+                }
+            }
+        }
+
+        // Called past the opening quote. Consumes a string without escapes, leaves any other one in place
+        std::optional<std::string_view> LoadPlainString(Buffer& buffer) {
+            const char* begin = buffer.position;
+            const char* stop = FindStringStop(begin, buffer.end);
+
+            if (stop == buffer.end || *stop != '"') {
+                return std::nullopt;
+            }
+
+            buffer.position = stop + 1;
+            return std::string_view(begin, stop - begin);
+        }
+
+        Node LoadString(Buffer& buffer) {
+            const std::optional<std::string_view> plain = LoadPlainString(buffer);
+
+            if (!buffer.is_borrowing) {
+                return plain.has_value() ? Node(std::string(*plain)) : Node(LoadStringContent(buffer));
+            }
+
+            if (plain.has_value()) {
+                return Node(*plain);
+            }
+
+            const std::string line = LoadStringContent(buffer);
+            char* stored = static_cast<char*>(buffer.resource->allocate(line.size(), alignof(char)));
+            std::copy(line.begin(), line.end(), stored);
+
+            return Node(std::string_view(stored, line.size()));
+        }
+
+    // 
+    // 
+    //                                                      + --------------
+    // ------------------------------------------------------ Array Loader +
+
+        Node LoadArray(Buffer& buffer) {
+            const std::size_t first = buffer.nodes.size();
+
+            SkipSpaces(buffer);
+            if (!buffer.IsEnd() && *buffer.position == ']') {
+                ++buffer.position;
+                return Node(Array(buffer.resource));
+            }
+
+            while (true) {
+                Node node = LoadNode(buffer);
+                buffer.nodes.push_back(std::move(node));
+                SkipSpaces(buffer);
+
+                if (buffer.IsEnd()) {
+                    throw ParsingError("Parsing Error [Array]. \"]\" has not been spotted.");
+                }
+
+                const char ch = *buffer.position++;
+                if (ch == ']') {
+                    return Node(buffer.TakeNodes(first));
+                }
+                if (ch != ',') {
+                    throw ParsingError("Parsing Error [Array]. Sign \",\" was expected but '"s + ch + "' has been spotted."s);
+                }
+            }
+        }
+
+    // 
+    // 
+    //                                                      + -------------------
+    // ------------------------------------------------------ Dictionary Loader +
+
+        Node LoadDict(Buffer& buffer) {
+            const std::size_t first = buffer.entries.size();
+
+            SkipSpaces(buffer);
+            if (!buffer.IsEnd() && *buffer.position == '}') {
+                ++buffer.position;
+                return Node(Dict(Dict::Entries(buffer.resource)));
+            }
+
+            while (true) {
+                if (buffer.IsEnd() || *buffer.position != '"') {
+                    throw ParsingError("Parsing Error [Dict]. A key was expected."s);
+                }
+
+                ++buffer.position;
+                std::pmr::string key(buffer.resource);
+
+                if (const std::optional<std::string_view> plain = LoadPlainString(buffer); plain.has_value()) {
+                    key.assign(*plain);
+                }
+                else {
+                    key.assign(LoadStringContent(buffer));
+                }
+
+                SkipSpaces(buffer);
+                if (buffer.IsEnd() || *buffer.position != ':') {
+                    throw ParsingError("Parsing Error [Dict]. Sign \":\" was expected after '"s + std::string(key) + "'."s);
+                }
+
+                ++buffer.position;
+                Node value = LoadNode(buffer);
+                buffer.entries.emplace_back(std::move(key), std::move(value));
+                SkipSpaces(buffer);
+
+                if (buffer.IsEnd()) {
+                    throw ParsingError("Parsing Error [Dict]."s);
+                }
+
+                const char ch = *buffer.position++;
+                if (ch == '}') {
+                    return Node(MakeDict(buffer.TakeEntries(first)));
+                }
+                if (ch != ',') {
+                    throw ParsingError("Parsing Error [Dict]. Sign \",\" was expected but '"s + ch + "' has been spotted."s);
+                }
+
+                SkipSpaces(buffer);
+            }
+        }
+
+    // 
+    // 
+    //                                                      + -------------
+    // ------------------------------------------------------ Node Loader +
+
+        Node LoadNode(Buffer& buffer) {
+            SkipSpaces(buffer);
+
+            if (buffer.IsEnd()) {
+                throw ParsingError("Parsing Error [char]. Unexpected end of input.");
+            }
+
+            const char c = *buffer.position;
+
+            if (c == '[') {
+                ++buffer.position;
+                return LoadArray(buffer);
+            }
+            else if (c == '{') {
+                ++buffer.position;
+                return LoadDict(buffer);
+            }
+            else if (c == '"') {
+                ++buffer.position;
+                return LoadString(buffer);
+            }
+            else if (c == 'n') {
+                return LoadNull(buffer);
+            }
+            else if (c == 't' || c == 'f') {
+                return LoadBool(buffer);
+            }
+            else if (c == '-' || isdigit(c)) {
+                return LoadIntAndDouble(buffer);
+            }
+
+            throw ParsingError("Parsing Error [char]. Invalid type has been spotted.");
+        }
+
+        // Only whitespace may follow the root value
+        void ExpectEnd(Buffer& buffer) {
+            SkipSpaces(buffer);
+
+            if (!buffer.IsEnd()) {
+                throw ParsingError("Parsing Error [char]. Unexpected content after the root value.");
+            }
+        }
+
+    // ------------ [Event Parser] Realization ------------
+    //                                                    +
+    //                                                    + ----------
+    // ---------------------------------------------------- Emitters +
+
+        void EmitNode(Buffer& buffer, Handler& handler);
+
+        // Called past the opening quote. An escaped string is unescaped into [unescaped]
+        std::string_view EmitStringContent(Buffer& buffer, std::string& unescaped) {
+            if (const std::optional<std::string_view> plain = LoadPlainString(buffer); plain.has_value()) {
+                return *plain;
+            }
+
+            unescaped = LoadStringContent(buffer);
+            return unescaped;
+        }
+
+        void EmitArray(Buffer& buffer, Handler& handler) {
+            handler.OnStartArray();
+
+            SkipSpaces(buffer);
+            if (!buffer.IsEnd() && *buffer.position == ']') {
+                ++buffer.position;
+                handler.OnEndArray();
+                return;
+            }
+
+            while (true) {
+                EmitNode(buffer, handler);
+                SkipSpaces(buffer);
+
+                if (buffer.IsEnd()) {
+                    throw ParsingError("Parsing Error [Array]. \"]\" has not been spotted.");
+                }
+
+                const char ch = *buffer.position++;
+                if (ch == ']') {
+                    handler.OnEndArray();
+                    return;
+                }
+                if (ch != ',') {
+                    throw ParsingError("Parsing Error [Array]. Sign \",\" was expected but '"s + ch + "' has been spotted."s);
+                }
+            }
+        }
+
+        void EmitDict(Buffer& buffer, Handler& handler) {
+            handler.OnStartDict();
+
+            SkipSpaces(buffer);
+            if (!buffer.IsEnd() && *buffer.position == '}') {
+                ++buffer.position;
+                handler.OnEndDict();
+                return;
+            }
+
+            std::string unescaped;
+            while (true) {
+                if (buffer.IsEnd() || *buffer.position != '"') {
+                    throw ParsingError("Parsing Error [Dict]. A key was expected."s);
+                }
+
+                ++buffer.position;
+                const std::string_view key = EmitStringContent(buffer, unescaped);
+
+                SkipSpaces(buffer);
+                if (buffer.IsEnd() || *buffer.position != ':') {
+                    throw ParsingError("Parsing Error [Dict]. Sign \":\" was expected after '"s + std::string(key) + "'."s);
+                }
+
+                ++buffer.position;
+                handler.OnKey(key);
+                EmitNode(buffer, handler);
+                SkipSpaces(buffer);
+
+                if (buffer.IsEnd()) {
+                    throw ParsingError("Parsing Error [Dict]."s);
+                }
+
+                const char ch = *buffer.position++;
+                if (ch == '}') {
+                    handler.OnEndDict();
+                    return;
+                }
+                if (ch != ',') {
+                    throw ParsingError("Parsing Error [Dict]. Sign \",\" was expected but '"s + ch + "' has been spotted."s);
+                }
+
+                SkipSpaces(buffer);
+            }
+        }
+
+        // Scalars go through the Node loaders, which keep the same validation
+        void EmitNode(Buffer& buffer, Handler& handler) {
+            SkipSpaces(buffer);
+
+            if (buffer.IsEnd()) {
+                throw ParsingError("Parsing Error [char]. Unexpected end of input.");
+            }
+
+            const char c = *buffer.position;
+
+            if (c == '[') {
+                ++buffer.position;
+                EmitArray(buffer, handler);
+            }
+            else if (c == '{') {
+                ++buffer.position;
+                EmitDict(buffer, handler);
+            }
+            else if (c == '"') {
+                ++buffer.position;
+                std::string unescaped;
+                handler.OnString(EmitStringContent(buffer, unescaped));
+            }
+            else if (c == 'n') {
+                LoadNull(buffer);
+                handler.OnNull();
+            }
+            else if (c == 't' || c == 'f') {
+                handler.OnBool(LoadBool(buffer).AsBool());
+            }
+            else if (c == '-' || isdigit(c)) {
+                const Node number = LoadIntAndDouble(buffer);
+
+                if (number.IsInt()) {
+                    handler.OnInt(number.AsInt());
+                }
+                else {
+                    handler.OnDouble(number.AsDouble());
+                }
+            }
+            else {
+                throw ParsingError("Parsing Error [char]. Invalid type has been spotted.");
+            }
+        }
     } // unnamed namespace
 
 // ------------ [Node] Realization ------------
@@ -341,6 +1019,14 @@ namespace json {
         : json_lib_(std::move(str)) {
     }
 
+    Node::Node(std::string_view str) noexcept
+        : json_lib_(str) {
+    }
+
+    Node::Node(const char* str)
+        : json_lib_(std::string(str)) {
+    }
+
     Node::Node(std::nullptr_t null) noexcept
         : json_lib_(null) {
     }
@@ -375,7 +1061,7 @@ namespace json {
     }
 
     bool Node::IsString() const noexcept {
-        return std::holds_alternative<std::string>(json_lib_);
+        return std::holds_alternative<std::string>(json_lib_) || std::holds_alternative<std::string_view>(json_lib_);
     }
 
     bool Node::IsNull() const noexcept {
@@ -416,7 +1102,11 @@ namespace json {
         return *Getter<bool>();
     }
 
-    const std::string& Node::AsString() const {
+    std::string_view Node::AsString() const {
+        if (const std::string_view* view = std::get_if<std::string_view>(&json_lib_); view != nullptr) {
+            return *view;
+        }
+
         return *Getter<std::string>();
     }
 
@@ -441,17 +1131,116 @@ namespace json {
         return json_lib_;
     }
 
+// 
+// 
+//                                            + ------
+// -------------------------------------------- Dict +
+
+    Dict::Dict(Entries entries)
+        : entries_(std::move(entries)) {
+    }
+
+    bool Dict::operator==(const Dict& other) const {
+        return entries_ == other.entries_;
+    }
+
+    bool Dict::operator!=(const Dict& other) const {
+        return !(*this == other);
+    }
+
+    std::size_t Dict::size() const noexcept {
+        return entries_.size();
+    }
+
+    bool Dict::empty() const noexcept {
+        return entries_.empty();
+    }
+
+    Dict::iterator Dict::begin() noexcept {
+        return entries_.begin();
+    }
+
+    Dict::iterator Dict::end() noexcept {
+        return entries_.end();
+    }
+
+    Dict::const_iterator Dict::begin() const noexcept {
+        return entries_.begin();
+    }
+
+    Dict::const_iterator Dict::end() const noexcept {
+        return entries_.end();
+    }
+
+    Dict::iterator Dict::find(std::string_view key) {
+        const const_iterator position = std::as_const(*this).find(key);
+        return entries_.begin() + (position - entries_.cbegin());
+    }
+
+    Dict::const_iterator Dict::find(std::string_view key) const {
+        if (entries_.size() <= LINEAR_LOOKUP_SIZE) {
+            return std::find_if(entries_.begin(), entries_.end(), [key](const Entry& entry) {
+                return entry.first == key;
+            });
+        }
+
+        const auto position = std::lower_bound(entries_.begin(), entries_.end(), key, [](const Entry& entry, std::string_view key) {
+            return entry.first < key;
+        });
+
+        return position != entries_.end() && position->first == key ? position : entries_.end();
+    }
+
+    bool Dict::contains(std::string_view key) const {
+        return find(key) != entries_.end();
+    }
+
+    Node& Dict::at(std::string_view key) {
+        return const_cast<Node&>(std::as_const(*this).at(key));
+    }
+
+    const Node& Dict::at(std::string_view key) const {
+        const const_iterator position = find(key);
+
+        if (position == entries_.end()) {
+            throw std::out_of_range("Key '"s + std::string(key) + "' is not in the Dict."s);
+        }
+
+        return position->second;
+    }
+
+    Node& Dict::operator[](std::string_view key) {
+        return emplace(key, Node{}).first->second;
+    }
+
+    std::pair<Dict::iterator, bool> Dict::emplace(std::string_view key, Node value) {
+        const auto position = std::lower_bound(entries_.begin(), entries_.end(), key, [](const Entry& entry, std::string_view key) {
+            return entry.first < key;
+        });
+
+        if (position != entries_.end() && position->first == key) {
+            return { position, false };
+        }
+
+        return { entries_.emplace(position, std::pmr::string(key, entries_.get_allocator()), std::move(value)), true };
+    }
+
 // 
 // 
 //                                            + ----------------
 // -------------------------------------------- Node operators +
 
+    // Owned and borrowed strings are equal by contents
     bool Node::operator==(const Node& other) const {
+        if (IsString() && other.IsString()) {
+            return AsString() == other.AsString();
+        }
+
         return this->json_lib_ == other.json_lib_;
     }
 
     bool Node::operator!=(const Node& other) const {
-        return this->json_lib_ != other.json_lib_;
+        return !(*this == other);
     }
 
 // ------------ [Storage & Main Loader] Realization ------------
@@ -463,25 +1252,55 @@ namespace json {
         : root_(std::move(root)) {
     }
 
+    Document::Document(std::unique_ptr<Arena> arena, const Node* arena_root)
+        : arena_(std::move(arena))
+        , arena_root_(arena_root) {
+    }
+
     const Node& Document::GetRoot() const {
-        return root_;
+        return arena_root_ != nullptr ? *arena_root_ : root_;
     }
 
     Document Load(std::istream& input) {
         return Document{ LoadNode(input) };
     }
 
+    Document Load(std::string_view input) {
+        Buffer buffer{ .position = input.data(), .end = input.data() + input.size() };
+        Node root = LoadNode(buffer);
+        ExpectEnd(buffer);
+
+        return Document{ std::move(root) };
+    }
+
+    // The root is placed in the arena as well and is never destroyed
+    Document LoadBorrowed(std::string_view input) {
+        auto arena = std::make_unique<Document::Arena>(std::max<std::size_t>(input.size(), 4096));
+        Buffer buffer{ .position = input.data(), .end = input.data() + input.size(), .is_borrowing = true, .resource = arena.get() };
+
+        Node* root = new (arena->allocate(sizeof(Node), alignof(Node))) Node(LoadNode(buffer));
+        ExpectEnd(buffer);
+
+        return Document(std::move(arena), root);
+    }
+
+    void Parse(std::string_view input, Handler& handler) {
+        Buffer buffer{ .position = input.data(), .end = input.data() + input.size() };
+        EmitNode(buffer, handler);
+        ExpectEnd(buffer);
+    }
+
 // 
 // 
 //                                                             + --------------------
 // ------------------------------------------------------------- Document operators +
 
     bool Document::operator==(const Document& other) const {
-        return this->root_ == other.root_;
+        return GetRoot() == other.GetRoot();
     }
 
     bool Document::operator!=(const Document& other) const {
-        return this->root_ != other.root_;
+        return GetRoot() != other.GetRoot();
     }
 
 // ------------ [Printers] Realization ------------
@@ -558,7 +1377,7 @@ namespace json {
         for (const auto& [str, entity] : doc.GetRoot().AsMap()) {
             if (is_first) {
                 output << "  "s;
-                Print(Document{ str }, output);
+                Print(Document{ Node(std::string_view(str)) }, output);
 
                 output << " : "s;
 
@@ -569,7 +1388,7 @@ namespace json {
             }
             output << ", "s << std::endl;
             output << "  "s;
-            Print(Document{ str }, output);
+            Print(Document{ Node(std::string_view(str)) }, output);
 
             output << " : "s;
 
@@ -2,8 +2,12 @@
 
 #include <cstddef>
 #include <iostream>
-#include <map>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -15,8 +19,49 @@ namespace json {
 
     class Node;
 
-    using Array = std::vector<Node>;
-    using Dict = std::map<std::string, Node>;
+    using Array = std::pmr::vector<Node>;
+
+    // Flat object: entries sorted by key in one contiguous array. Request objects have a handful
+    // of keys, so a lookup is a short linear scan, and a binary search in larger objects
+    class Dict final {
+    public:
+        using Entry = std::pair<std::pmr::string, Node>;
+        using Entries = std::pmr::vector<Entry>;
+        using iterator = Entries::iterator;
+        using const_iterator = Entries::const_iterator;
+
+        Dict() = default;
+
+        // [entries] must be sorted by key and have no duplicate keys
+        explicit Dict(Entries entries);
+
+        bool operator==(const Dict& other) const;
+        bool operator!=(const Dict& other) const;
+
+        std::size_t size() const noexcept;
+        bool empty() const noexcept;
+
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+
+        iterator find(std::string_view key);
+        const_iterator find(std::string_view key) const;
+        bool contains(std::string_view key) const;
+
+        Node& at(std::string_view key);
+        const Node& at(std::string_view key) const;
+
+        // Inserts a null node if [key] is missing
+        Node& operator[](std::string_view key);
+        std::pair<iterator, bool> emplace(std::string_view key, Node value);
+
+    private:
+        static constexpr std::size_t LINEAR_LOOKUP_SIZE = 8;
+
+        Entries entries_;
+    };
 
     class ParsingError : public std::runtime_error {
     public:
@@ -25,7 +70,8 @@ namespace json {
 
     class Node final {
     public:
-        using Value = std::variant<std::nullptr_t, int, double, bool, std::string, Array, Dict>;
+        // A std::string_view refers to the buffer of LoadBorrowed() or to other storage outliving the node
+        using Value = std::variant<std::nullptr_t, int, double, bool, std::string, Array, Dict, std::string_view>;
 
         bool operator==(const Node& other) const;
         bool operator!=(const Node& other) const;
@@ -37,6 +83,8 @@ namespace json {
         Node(double value) noexcept;
         Node(bool boolean) noexcept;
         Node(std::string str);
+        Node(std::string_view str) noexcept;
+        Node(const char* str);
         Node(std::nullptr_t null) noexcept;
         Node(Array array);
         Node(Dict map);
@@ -53,7 +101,7 @@ namespace json {
         int AsInt() const;
         double AsDouble() const;
         bool AsBool() const;
-        const std::string& AsString() const;
+        std::string_view AsString() const;
         const Array& AsArray() const;
         const Dict& AsMap() const;
 
@@ -90,11 +138,57 @@ namespace json {
         const Node& GetRoot() const;
 
     private:
+        friend Document LoadBorrowed(std::string_view input);
+
+        using Arena = std::pmr::monotonic_buffer_resource;
+
+        Document(std::unique_ptr<Arena> arena, const Node* arena_root);
+
+        // Nodes of an arena document own no memory outside [arena_], so they are released
+        // with it at once, without being destroyed one by one
+        std::unique_ptr<Arena> arena_;
+        const Node* arena_root_ = nullptr;
         Node root_;
     };
 
     Document Load(std::istream& input);
 
+    // Parses a contiguous buffer in place, much faster than the stream overload on large inputs.
+    // Only whitespace may follow the root value
+    Document Load(std::string_view input);
+
+    // Same as Load(std::string_view), but strings without escapes refer to [input] instead of
+    // being copied, so [input] must outlive the document. Containers and escaped strings are
+    // allocated in an arena owned by the document
+    Document LoadBorrowed(std::string_view input);
+
+// ------------ [Event Parser] Definition ------------
+//                                                   +
+//                                                   + ---------
+// --------------------------------------------------- Handler +
+
+    // Receives keys and values in the order of the input, so no tree is built.
+    // Views are valid only during the call. Duplicate keys are not detected
+    class Handler {
+    public:
+        virtual void OnNull() = 0;
+        virtual void OnBool(bool value) = 0;
+        virtual void OnInt(int value) = 0;
+        virtual void OnDouble(double value) = 0;
+        virtual void OnString(std::string_view value) = 0;
+
+        virtual void OnStartArray() = 0;
+        virtual void OnEndArray() = 0;
+        virtual void OnStartDict() = 0;
+        virtual void OnKey(std::string_view key) = 0;
+        virtual void OnEndDict() = 0;
+
+        virtual ~Handler() = default;
+    };
+
+    // Parses a contiguous buffer in place, passing every key and value to [handler]
+    void Parse(std::string_view input, Handler& handler);
+
 // ------------ [Printers] Definition ------------
 //                                               +
 //                                               + ----------
@@ -1,9 +1,395 @@
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory_resource>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "json_reader.h"
 
 namespace json_reader {
+	namespace {
+// ------------ [Requests Handler] Definition ------------
+//                                                       +
+//                                                       + ------------------
+// ------------------------------------------------------- Requests Handler +
+
+		// Streams "base_requests" into the catalogue while the input is parsed. Stops are added as soon as
+		// their objects end; road distances and buses may refer to stops that come later, so they wait
+		// in compact lists of interned names. The other sections are rebuilt as a document
+		class RequestsHandler final : public json::Handler {
+		public:
+			explicit RequestsHandler(catalogue::TransportCatalogue& database);
+
+			void OnNull() override;
+			void OnBool(bool value) override;
+			void OnInt(int value) override;
+			void OnDouble(double value) override;
+			void OnString(std::string_view value) override;
+
+			void OnStartArray() override;
+			void OnEndArray() override;
+			void OnStartDict() override;
+			void OnKey(std::string_view key) override;
+			void OnEndDict() override;
+
+			// Adds the pending road distances and buses, then releases them.
+			// Throws std::invalid_argument if one of them refers to an unknown stop
+			void FillCatalogue();
+			json::Document TakeOtherRequests();
+
+		private:
+			enum class Field {
+				OTHER,
+				TYPE,
+				NAME,
+				LATITUDE,
+				LONGITUDE,
+				ROAD_DISTANCES,
+				STOPS,
+				IS_ROUNDTRIP
+			};
+
+			struct PendingDistance final {
+				std::uint32_t from;
+				std::uint32_t to;
+				std::uint32_t length;
+			};
+
+			struct PendingBus final {
+				std::uint32_t name;
+				std::uint32_t first_stop;
+				std::uint32_t stop_count;
+				bool is_roundtrip;
+			};
+
+			// Depths of the values inside the root object, inside a request and inside a container field of a request
+			static constexpr std::size_t SECTION_DEPTH = 1;
+			static constexpr std::size_t REQUEST_DEPTH = 3;
+			static constexpr std::size_t FIELD_DEPTH = 4;
+
+			// Interned names that are not stops, like the names of buses
+			static constexpr domain::StopId NO_STOP = std::numeric_limits<domain::StopId>::max();
+
+			static Field ChooseField(std::string_view key);
+
+			std::uint32_t InternName(std::string_view name);
+			void StartRequest();
+			void FinishRequest();
+
+			catalogue::TransportCatalogue& database_;
+			json::Builder other_requests_;
+
+			std::size_t depth_ = 0;
+			bool is_streaming_ = false;
+
+			// The request being read
+			Field field_ = Field::OTHER;
+			bool is_bus_ = false;
+			std::string name_;
+			geo::Coordinates coordinates_;
+			bool is_roundtrip_ = false;
+			std::uint32_t destination_ = 0;
+			std::size_t first_distance_ = 0;
+			std::size_t first_stop_ = 0;
+
+			std::pmr::monotonic_buffer_resource names_storage_;
+			std::unordered_map<std::string_view, std::uint32_t> name_ids_;
+			std::vector<std::string_view> names_;
+
+			std::vector<PendingDistance> distances_;
+			std::vector<std::uint32_t> bus_stops_;
+			std::vector<PendingBus> buses_;
+		};
+
+// ------------ [Requests Handler] Realization ------------
+//                                                        +
+//                                                        + --------
+// -------------------------------------------------------- Values +
+
+		RequestsHandler::RequestsHandler(catalogue::TransportCatalogue& database)
+			: database_(database) {
+		}
+
+		void RequestsHandler::OnNull() {
+			if (!is_streaming_) {
+				other_requests_.Value(nullptr);
+			}
+		}
+
+		void RequestsHandler::OnBool(bool value) {
+			if (!is_streaming_) {
+				other_requests_.Value(value);
+			}
+			else if (depth_ == REQUEST_DEPTH && field_ == Field::IS_ROUNDTRIP) {
+				is_roundtrip_ = value;
+			}
+		}
+
+		void RequestsHandler::OnInt(int value) {
+			if (!is_streaming_) {
+				other_requests_.Value(value);
+			}
+			else if (depth_ == FIELD_DEPTH && field_ == Field::ROAD_DISTANCES) {
+				distances_.push_back(PendingDistance{ .from = 0, .to = destination_, .length = static_cast<std::uint32_t>(value) });
+			}
+			else {
+				OnDouble(value);
+			}
+		}
+
+		void RequestsHandler::OnDouble(double value) {
+			if (!is_streaming_) {
+				other_requests_.Value(value);
+			}
+			else if (depth_ == REQUEST_DEPTH && field_ == Field::LATITUDE) {
+				coordinates_.lat = value;
+			}
+			else if (depth_ == REQUEST_DEPTH && field_ == Field::LONGITUDE) {
+				coordinates_.lng = value;
+			}
+			else if (depth_ == FIELD_DEPTH && field_ == Field::ROAD_DISTANCES) {
+				using namespace std::literals;
+				throw std::invalid_argument("Road distance to stop '"s + std::string(names_[destination_]) + "' is not an integer"s);
+			}
+		}
+
+		void RequestsHandler::OnString(std::string_view value) {
+			using namespace std::literals;
+
+			if (!is_streaming_) {
+				other_requests_.Value(std::string(value));
+			}
+			else if (depth_ == REQUEST_DEPTH && field_ == Field::TYPE) {
+				is_bus_ = value == "Bus"sv;
+			}
+			else if (depth_ == REQUEST_DEPTH && field_ == Field::NAME) {
+				name_.assign(value);
+			}
+			else if (depth_ == FIELD_DEPTH && field_ == Field::STOPS) {
+				bus_stops_.push_back(InternName(value));
+			}
+		}
+
+// 
+// 
+//                                                        + ------------
+// -------------------------------------------------------- Containers +
+
+		void RequestsHandler::OnStartArray() {
+			if (!is_streaming_) {
+				other_requests_.StartArray();
+			}
+
+			++depth_;
+		}
+
+		void RequestsHandler::OnEndArray() {
+			--depth_;
+
+			if (!is_streaming_) {
+				other_requests_.EndArray();
+			}
+			else if (depth_ == SECTION_DEPTH) {
+				is_streaming_ = false;
+			}
+		}
+
+		void RequestsHandler::OnStartDict() {
+			if (!is_streaming_) {
+				other_requests_.StartDict();
+			}
+			else if (depth_ == REQUEST_DEPTH - 1) {
+				StartRequest();
+			}
+
+			++depth_;
+		}
+
+		void RequestsHandler::OnKey(std::string_view key) {
+			using namespace std::literals;
+
+			if (!is_streaming_) {
+				if (depth_ == SECTION_DEPTH && key == "base_requests"sv) {
+					is_streaming_ = true;
+					return;
+				}
+
+				other_requests_.Key(std::string(key));
+			}
+			else if (depth_ == REQUEST_DEPTH) {
+				field_ = ChooseField(key);
+			}
+			else if (depth_ == FIELD_DEPTH && field_ == Field::ROAD_DISTANCES) {
+				destination_ = InternName(key);
+			}
+		}
+
+		void RequestsHandler::OnEndDict() {
+			--depth_;
+
+			if (!is_streaming_) {
+				other_requests_.EndDict();
+			}
+			else if (depth_ == REQUEST_DEPTH - 1) {
+				FinishRequest();
+			}
+		}
+
+// 
+// 
+//                                                        + ----------
+// -------------------------------------------------------- Requests +
+
+		RequestsHandler::Field RequestsHandler::ChooseField(std::string_view key) {
+			using namespace std::literals;
+
+			if (key == "type"sv) {
+				return Field::TYPE;
+			}
+			else if (key == "name"sv) {
+				return Field::NAME;
+			}
+			else if (key == "latitude"sv) {
+				return Field::LATITUDE;
+			}
+			else if (key == "longitude"sv) {
+				return Field::LONGITUDE;
+			}
+			else if (key == "road_distances"sv) {
+				return Field::ROAD_DISTANCES;
+			}
+			else if (key == "stops"sv) {
+				return Field::STOPS;
+			}
+			else if (key == "is_roundtrip"sv) {
+				return Field::IS_ROUNDTRIP;
+			}
+
+			return Field::OTHER;
+		}
+
+		std::uint32_t RequestsHandler::InternName(std::string_view name) {
+			if (const auto position = name_ids_.find(name); position != name_ids_.end()) {
+				return position->second;
+			}
+
+			char* stored = static_cast<char*>(names_storage_.allocate(name.size(), alignof(char)));
+			std::copy(name.begin(), name.end(), stored);
+
+			const std::uint32_t id = static_cast<std::uint32_t>(names_.size());
+			names_.emplace_back(stored, name.size());
+			name_ids_.emplace(names_.back(), id);
+			return id;
+		}
+
+		// Distances and stops of a request are appended to the pending lists right away
+		void RequestsHandler::StartRequest() {
+			field_ = Field::OTHER;
+			is_bus_ = false;
+			name_.clear();
+			coordinates_ = {};
+			is_roundtrip_ = false;
+			first_distance_ = distances_.size();
+			first_stop_ = bus_stops_.size();
+		}
+
+		// Road distances belong to stops and stop lists to buses; the other request type drops them
+		void RequestsHandler::FinishRequest() {
+			const std::uint32_t name = InternName(name_);
+
+			if (is_bus_) {
+				distances_.resize(first_distance_);
+				buses_.push_back(PendingBus{
+					.name = name,
+					.first_stop = static_cast<std::uint32_t>(first_stop_),
+					.stop_count = static_cast<std::uint32_t>(bus_stops_.size() - first_stop_),
+					.is_roundtrip = is_roundtrip_
+				});
+				return;
+			}
+
+			bus_stops_.resize(first_stop_);
+			database_.AddStop(name_, coordinates_);
+
+			for (std::size_t index = first_distance_; index < distances_.size(); ++index) {
+				distances_[index].from = name;
+			}
+		}
+
+// 
+// 
+//                                                        + -----------------
+// -------------------------------------------------------- Pending filling +
+
+		// Every interned name is looked up in the catalogue once
+		void RequestsHandler::FillCatalogue() {
+			using namespace std::literals;
+
+			std::vector<domain::StopId> stop_ids(names_.size(), NO_STOP);
+			for (std::size_t name = 0; name < names_.size(); ++name) {
+				if (const domain::Stop* stop = database_.FindStop(names_[name]); stop != nullptr) {
+					stop_ids[name] = stop->id;
+				}
+			}
+
+			// [describe_owner] names the request in the error message
+			auto resolve = [this, &stop_ids](std::uint32_t name, auto describe_owner) {
+				if (stop_ids[name] == NO_STOP) {
+					throw std::invalid_argument("Unknown stop '"s + std::string(names_[name]) + "' in "s + describe_owner());
+				}
+
+				return stop_ids[name];
+			};
+
+			for (const PendingDistance& distance : distances_) {
+				const domain::StopId to = resolve(distance.to, [this, &distance] {
+					return "road_distances of stop '"s + std::string(names_[distance.from]) + "'"s;
+				});
+
+				database_.AddDestination(stop_ids[distance.from], to, distance.length);
+			}
+
+			std::vector<domain::StopId> proper_stops;
+			for (const PendingBus& bus : buses_) {
+				const auto first = bus_stops_.begin() + bus.first_stop;
+				const auto last = first + bus.stop_count;
+
+				auto describe_bus = [this, &bus] {
+					return "stops of bus '"s + std::string(names_[bus.name]) + "'"s;
+				};
+
+				proper_stops.clear();
+				for (auto it = first; it != last; ++it) {
+					proper_stops.push_back(resolve(*it, describe_bus));
+				}
+
+				if (!bus.is_roundtrip && first != last) {
+					for (auto it = last - 1; it != first; --it) {
+						proper_stops.push_back(proper_stops[it - 1 - first]);
+					}
+				}
+
+				database_.AddBus(names_[bus.name], proper_stops, bus.is_roundtrip);
+			}
+
+			distances_ = {};
+			bus_stops_ = {};
+			buses_ = {};
+			name_ids_ = {};
+			names_ = {};
+			names_storage_.release();
+		}
+
+		json::Document RequestsHandler::TakeOtherRequests() {
+			return json::Document(other_requests_.Build());
+		}
+	} // unnamed namespace
+
 // ------------ [Json Reader] Realization ------------
 //                                                   +
 //                                                   + -------------
@@ -21,7 +407,7 @@ namespace json_reader {
 
 	const svg::Color JsonReader::ChooseColor(const json::Node& to_process) const {
 		if (to_process.IsString()) {
-			return to_process.AsString();
+			return std::string(to_process.AsString());
 		}
 		else if (to_process.AsArray().size() == 3) {
 			svg::Rgb to_add = { static_cast<std::uint8_t>(to_process.AsArray().front().AsInt()),
@@ -38,6 +424,49 @@ namespace json_reader {
 		return to_add;
 	}
 
+	domain::RouterEngine JsonReader::ChooseRouterEngine(const json::Dict& routing_settings) const {
+		using namespace std::literals;
+
+		if (!routing_settings.contains("router"s)) {
+			return domain::RouterEngine::FLOYD_WARSHALL;
+		}
+
+		const std::string_view engine = routing_settings.at("router"s).AsString();
+
+		if (engine == "floyd_warshall"s) {
+			return domain::RouterEngine::FLOYD_WARSHALL;
+		}
+		else if (engine == "blocked_floyd_warshall"s) {
+			return domain::RouterEngine::BLOCKED_FLOYD_WARSHALL;
+		}
+		else if (engine == "compact_floyd_warshall"s) {
+			return domain::RouterEngine::COMPACT_FLOYD_WARSHALL;
+		}
+		else if (engine == "dijkstra"s) {
+			return domain::RouterEngine::DIJKSTRA;
+		}
+		else if (engine == "dijkstra_fixed_point"s) {
+			return domain::RouterEngine::DIJKSTRA_FIXED_POINT;
+		}
+		else if (engine == "a_star"s) {
+			return domain::RouterEngine::A_STAR;
+		}
+		else if (engine == "alt"s) {
+			return domain::RouterEngine::ALT;
+		}
+		else if (engine == "row_cache"s) {
+			return domain::RouterEngine::ROW_CACHE;
+		}
+		else if (engine == "contraction_hierarchy"s) {
+			return domain::RouterEngine::CONTRACTION_HIERARCHY;
+		}
+		else if (engine == "raptor"s) {
+			return domain::RouterEngine::RAPTOR;
+		}
+
+		throw std::invalid_argument("Unknown router engine: "s + std::string(engine));
+	}
+
 // 
 // 
 //                                                   + ---------------------------
@@ -66,8 +495,7 @@ namespace json_reader {
 					}
 
 					for (auto it = to_parse.at("stops"s).AsArray().rbegin() + 1; it != to_parse.at("stops"s).AsArray().rend(); ++it) {
-						const std::string& stop = it->AsString();
-						proper_stops.push_back(stop);
+						proper_stops.push_back(it->AsString());
 					}
 
 					is_roundtrop = false;
@@ -80,7 +508,7 @@ namespace json_reader {
 			database_.AddStop(to_parse.at("name"s).AsString(), { to_parse.at("latitude"s).AsDouble(), to_parse.at("longitude"s).AsDouble() });
 
 			if (to_parse.contains("road_distances"s)) {
-				parameters.stops_and_destinations[to_parse.at("name"s).AsString()] = to_parse.at("road_distances"s).AsMap();
+				parameters.stops_and_destinations[to_parse.at("name"s).AsString()] = &to_parse.at("road_distances"s).AsMap();
 			}
 		}
 	}
@@ -90,10 +518,10 @@ namespace json_reader {
 //                                                   + ----------------------------------
 // --------------------------------------------------- Catalogue [Destinations filling] +
 
-	void JsonReader::CatalogueDestinationsFilling(std::unordered_map<std::string_view, json::Dict>& stops_and_destinations) {
+	void JsonReader::CatalogueDestinationsFilling(std::unordered_map<std::string_view, const json::Dict*>& stops_and_destinations) {
 		for (const auto& [stop, destinations] : stops_and_destinations) {
-			for (const auto& [destination, length] : destinations) {
-				database_.AddDestination(std::string(stop), destination, length.AsInt());
+			for (const auto& [destination, length] : *destinations) {
+				database_.AddDestination(stop, destination, length.AsInt());
 			}
 		}
 	}
@@ -105,7 +533,7 @@ namespace json_reader {
 
 	void JsonReader::CatalogueBusesFilling(std::unordered_map<std::string_view, std::pair<std::vector<std::string_view>, bool>>& buses) {
 		for (const auto& [name, proper_stops] : buses) {
-			database_.AddBus(std::string(name), proper_stops.first, proper_stops.second);
+			database_.AddBus(name, proper_stops.first, proper_stops.second);
 		}
 	}
 
@@ -117,7 +545,7 @@ namespace json_reader {
 	void JsonReader::HandleBaseRequests(const json::Document& document) {
 		using namespace std::literals;
 
-		std::unordered_map<std::string_view, json::Dict> stops_and_destinations;
+		std::unordered_map<std::string_view, const json::Dict*> stops_and_destinations;
 		std::unordered_map<std::string_view, std::pair<std::vector<std::string_view>, bool>> buses;
 
 		CatalogueStopsFilling(document, JsonReader::CatalogueStopsFillingParameters {
@@ -127,6 +555,8 @@ namespace json_reader {
 
 		CatalogueDestinationsFilling(stops_and_destinations);
 		CatalogueBusesFilling(buses);
+
+		database_.Freeze();
 	}
 
 // 
@@ -162,90 +592,13 @@ namespace json_reader {
 		renderer_.SetColorPalette(std::move(color_palette));
 	}
 
-// 
-// 
-//                                                   + -----------------------------------------
-// --------------------------------------------------- Renderer filling [Making stop database] +
-
-	void JsonReader::MakeStopDatabase(const json::Document& document, const JsonReader::MakeStopDatabaseParameters& parameters) {
-		using namespace std::literals;
-
-		for (const auto& bus_or_stop : document.GetRoot().AsMap().at("base_requests"s).AsArray()) {
-			const json::Dict& to_parse = bus_or_stop.AsMap();
-
-			if (to_parse.at("type"s) == "Bus"s) {
-				std::vector<std::string_view> proper_stops;
-
-				if (to_parse.at("is_roundtrip"s).AsBool()) {
-					for (const auto& stop : to_parse.at("stops"s).AsArray()) {
-						proper_stops.push_back(stop.AsString());
-					}
-				}
-				else {
-					for (const auto& stop : to_parse.at("stops"s).AsArray()) {
-						proper_stops.push_back(stop.AsString());
-					}
-
-					for (auto it = to_parse.at("stops"s).AsArray().rbegin() + 1; it != to_parse.at("stops"s).AsArray().rend(); ++it) {
-						const std::string& stop = it->AsString();
-						proper_stops.push_back(stop);
-					}
-				}
-
-				parameters.buses_and_stops[to_parse.at("name"s).AsString()] = { proper_stops, to_parse.at("is_roundtrip"s).AsBool() };
-				continue;
-			}
-
-			parameters.deque_stops.push_back({ to_parse.at("name"s).AsString(), { to_parse.at("latitude"s).AsDouble(), to_parse.at("longitude"s).AsDouble() } });
-		}
-	}
-
-// 
-// 
-//                         + -----------------------------------------------------------
-// ------------------------- Renderer filling [Making bus database & Sorted stop list] +
-
-	void JsonReader::MakeBusDatabase(const JsonReader::MakeBusDatabaseParameters& parameters) {
-		for (const auto& [bus_name, proper_stops] : parameters.buses_and_stops) {
-			domain::Bus bus_to_process({ std::string(bus_name), std::vector<domain::Stop*>{} });
-
-			for (const auto& proper_stop : proper_stops.first) {
-				bus_to_process.stops_with_duplicates.push_back(&*std::find(parameters.deque_stops.begin(), parameters.deque_stops.end(), proper_stop));
-				parameters.sorted_stops.insert(proper_stop);
-			}
-
-			parameters.routes.push_back({ bus_to_process, proper_stops.second });
-		}
-	}
-
 // 
 // 
 //                                                   + -------------------------
 // --------------------------------------------------- Renderer filling Facade +
 
 	void JsonReader::HandleRenderRequests(const json::Document& document) {
-		std::map<std::string_view, std::pair<std::vector<std::string_view>, bool>> buses_and_stops;
-
-		std::deque<domain::Stop> deque_stops;
-		std::set<std::string_view> sorted_stops;
-		std::deque<std::pair<domain::Bus, bool>> routes;
-
 		ExtractSettings(document);
-		MakeStopDatabase(document, JsonReader::MakeStopDatabaseParameters {
-			.buses_and_stops = buses_and_stops,
-			.deque_stops = deque_stops 
-		});
-
-		MakeBusDatabase(JsonReader::MakeBusDatabaseParameters {
-			.buses_and_stops = buses_and_stops,
-			.deque_stops = deque_stops,
-			.sorted_stops = sorted_stops,
-			.routes = routes
-		});
-
-		renderer_.SetDequeStops(std::move(deque_stops));
-		renderer_.SetSortedStops(std::move(sorted_stops));
-		renderer_.SetRoutes(std::move(routes));
 	}
 
 // 
@@ -257,10 +610,17 @@ namespace json_reader {
 		using namespace std::literals;
 
 		const json::Dict& to_parse = document.GetRoot().AsMap().at("routing_settings"s).AsMap();
-		transport_router_ = std::make_unique<transport_router::TransportRouter>(std::ref(database_), domain::RoutingSettings {
+		domain::RoutingSettings routing_settings {
 			.bus_wait_time = static_cast<std::uint16_t>(to_parse.at("bus_wait_time"s).AsInt()),
-			.bus_velocity = to_parse.at("bus_velocity"s).AsDouble()
-		});
+			.bus_velocity = to_parse.at("bus_velocity"s).AsDouble(),
+			.engine = ChooseRouterEngine(to_parse)
+		};
+
+		if (to_parse.contains("row_cache_budget_mb"s)) {
+			routing_settings.row_cache_budget = static_cast<std::size_t>(to_parse.at("row_cache_budget_mb"s).AsDouble() * (1 << 20));
+		}
+
+		transport_router_ = std::make_unique<transport_router::TransportRouter>(std::ref(database_), routing_settings);
 	}
 
 // 
@@ -342,45 +702,26 @@ namespace json_reader {
 	void JsonReader::ProcessRouteRequest(const json::Dict& to_parse, json::Builder& builder) const {
 		using namespace std::literals;
 
-		const domain::Data data = transport_router_->GetDataToBuildOptimalRoute(to_parse.at("from"s).AsString(), to_parse.at("to"s).AsString());
-
-		if (data.route.has_value()) {
-			std::uint16_t bus_wait_time = data.bus_wait_time;
-			std::optional<graph::VertexId> old_to;
+		// Unknown stops are answered like unreachable ones
+		const domain::Stop* from = database_.FindStop(to_parse.at("from"s).AsString());
+		const domain::Stop* to = database_.FindStop(to_parse.at("to"s).AsString());
+		const std::optional<domain::Route> route = from != nullptr && to != nullptr
+			? transport_router_->BuildRoute(from->id, to->id) : std::nullopt;
 
+		if (route.has_value()) {
 			builder.StartDict().Key("items"s).StartArray();
 
-			if (data.route.value().edges.size() == 1) {
-				builder.EndArray();
-
-				builder.Key("request_id"s).Value(to_parse.at("id"s).AsInt())
-					.Key("total_time"s).Value(data.route.value().weight)
-					.EndDict();
-			}
-
-			for (const auto& edge : data.route.value().edges) {
-				graph::Edge<double> vertices = data.graph.GetEdge(edge);
-
-				if (!old_to.has_value() || (vertices.from + 1 == vertices.to && old_to.value() != vertices.from)) {
-					builder.StartDict().Key("stop_name"s).Value(data.graph_stops.at(vertices.from).name)
-						.Key("time"s).Value(bus_wait_time)
+			for (const domain::RouteItem& item : route->items) {
+				if (item.type == domain::RouteItem::Type::WAIT) {
+					builder.StartDict().Key("stop_name"s).Value(database_.GetStop(item.stop).name)
+						.Key("time"s).Value(item.time)
 						.Key("type"s).Value("Wait"s)
 						.EndDict();
-
-					old_to = vertices.to;
 				}
 				else {
-					const std::string& from_name = data.graph_stops.at(vertices.from).name;
-					const std::string& to_name = data.graph_stops.at(vertices.to).name;
-
-					const domain::SpanInfo span_info {
-						.span_count = data.spans.at(std::make_pair(from_name, to_name)).begin()->first,
-						.buses = &data.spans.at(std::make_pair(from_name, to_name)).begin()->second
-					};
-
-					builder.StartDict().Key("bus"s).Value(std::string((*span_info.buses)[0]))
-						.Key("span_count"s).Value(static_cast<int>(span_info.span_count))
-						.Key("time"s).Value(data.router->BuildRoute(vertices.from, vertices.to).value().weight)
+					builder.StartDict().Key("bus"s).Value(database_.GetBus(item.bus).name)
+						.Key("span_count"s).Value(static_cast<int>(item.span_count))
+						.Key("time"s).Value(item.time)
 						.Key("type"s).Value("Bus"s)
 						.EndDict();
 				}
@@ -389,7 +730,32 @@ namespace json_reader {
 			builder.EndArray();
 
 			builder.Key("request_id"s).Value(to_parse.at("id"s).AsInt())
-				.Key("total_time"s).Value(data.route.value().weight)
+				.Key("total_time"s).Value(route->total_time)
+				.EndDict();
+		}
+		else {
+			builder.StartDict().Key("error_message"s).Value("not found"s)
+				.Key("request_id"s).Value(to_parse.at("id"s).AsInt())
+				.EndDict();
+		}
+	}
+
+// 
+// 
+//                                                   + ---------------------------------------
+// --------------------------------------------------- Stat Request [TravelTime processing] +
+
+	void JsonReader::ProcessTravelTimeRequest(const json::Dict& to_parse, json::Builder& builder) const {
+		using namespace std::literals;
+
+		const domain::Stop* from = database_.FindStop(to_parse.at("from"s).AsString());
+		const domain::Stop* to = database_.FindStop(to_parse.at("to"s).AsString());
+		const std::optional<double> total_time = from != nullptr && to != nullptr
+			? transport_router_->ComputeTravelTime(from->id, to->id) : std::nullopt;
+
+		if (total_time.has_value()) {
+			builder.StartDict().Key("request_id"s).Value(to_parse.at("id"s).AsInt())
+				.Key("total_time"s).Value(*total_time)
 				.EndDict();
 		}
 		else {
@@ -399,6 +765,35 @@ namespace json_reader {
 		}
 	}
 
+// 
+// 
+//                                                   + ----------------------------------------
+// --------------------------------------------------- Stat Request [RouterStats processing] +
+
+	void JsonReader::ProcessRouterStatsRequest(const json::Dict& to_parse, json::Builder& builder) const {
+		using namespace std::literals;
+
+		builder.StartDict().Key("request_id"s).Value(to_parse.at("id"s).AsInt());
+
+		if (const auto row_cache = transport_router_->GetRowCacheStats()) {
+			builder.Key("row_cache"s).StartDict()
+				.Key("evictions"s).Value(static_cast<int>(row_cache->evictions))
+				.Key("hits"s).Value(static_cast<int>(row_cache->hits))
+				.Key("misses"s).Value(static_cast<int>(row_cache->misses))
+				.Key("row_capacity"s).Value(static_cast<int>(row_cache->row_capacity))
+				.EndDict();
+		}
+
+		if (const auto travel_time_index = transport_router_->GetTravelTimeIndexStats()) {
+			builder.Key("travel_time_index"s).StartDict()
+				.Key("entries"s).Value(static_cast<int>(travel_time_index->entry_count))
+				.Key("memory_bytes"s).Value(static_cast<int>(travel_time_index->memory_usage))
+				.EndDict();
+		}
+
+		builder.EndDict();
+	}
+
 // 
 // 
 //                                                   + ---------------------
@@ -427,6 +822,16 @@ namespace json_reader {
 				continue;
 			}
 
+			if (to_parse.at("type"s) == "TravelTime"s) {
+				ProcessTravelTimeRequest(to_parse, builder);
+				continue;
+			}
+
+			if (to_parse.at("type"s) == "RouterStats"s) {
+				ProcessRouterStatsRequest(to_parse, builder);
+				continue;
+			}
+
 			ProcessRouteRequest(to_parse, builder);
 		}
 
@@ -439,10 +844,42 @@ namespace json_reader {
 // --------------------------------------------------- Facade of All Requests +
 
 	json::Document JsonReader::HandleRequests(const json::Document& document) {
-		std::thread base_requests_thread(&JsonReader::HandleBaseRequests, this, std::cref(document));
+		return HandleRequests(document, [this, &document] {
+			HandleBaseRequests(document);
+		});
+	}
+
+	json::Document JsonReader::HandleRequests(std::string_view input) {
+		RequestsHandler handler(database_);
+		json::Parse(input, handler);
+		const json::Document document = handler.TakeOtherRequests();
+
+		return HandleRequests(document, [this, &handler] {
+			handler.FillCatalogue();
+			database_.Freeze();
+		});
+	}
+
+	// An error in the base requests is rethrown to the caller once both threads have finished
+	json::Document JsonReader::HandleRequests(const json::Document& document, const std::function<void()>& handle_base_requests) {
+		std::exception_ptr base_requests_error;
+		std::thread base_requests_thread([&handle_base_requests, &base_requests_error] {
+			try {
+				handle_base_requests();
+			}
+			catch (...) {
+				base_requests_error = std::current_exception();
+			}
+		});
 		std::thread render_requests_thread(&JsonReader::HandleRenderRequests, this, std::cref(document));
 
 		base_requests_thread.join();
+		if (base_requests_error) {
+			render_requests_thread.join();
+			std::rethrow_exception(base_requests_error);
+		}
+
+		renderer_.SetSnapshot(database_.GetSnapshot());
 		HandleRoutingSettingsRequests(document);
 
 		render_requests_thread.join();
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <string_view>
+
 #include "json.h"
 #include "json_builder.h"
 #include "map_renderer.h"
@@ -20,43 +24,38 @@ namespace json_reader {
 
 		json::Document HandleRequests(const json::Document& document);
 
+		// Parses [input] without building its document: base requests are streamed into the catalogue,
+		// only the other sections are kept as a tree
+		json::Document HandleRequests(std::string_view input);
+
 	private:
 		struct CatalogueStopsFillingParameters final {
 			std::unordered_map<std::string_view, std::pair<std::vector<std::string_view>, bool>>& buses;
-			std::unordered_map<std::string_view, json::Dict>& stops_and_destinations;
+			std::unordered_map<std::string_view, const json::Dict*>& stops_and_destinations;
 		};
 
-		struct MakeStopDatabaseParameters final {
-			std::map<std::string_view, std::pair<std::vector<std::string_view>, bool>>& buses_and_stops;
-			std::deque<domain::Stop>& deque_stops;
-		};
-
-		struct MakeBusDatabaseParameters final {
-			std::map<std::string_view, std::pair<std::vector<std::string_view>, bool>>& buses_and_stops;
-			std::deque<domain::Stop>& deque_stops;
-			std::set<std::string_view>& sorted_stops;
-			std::deque<std::pair<domain::Bus, bool>>& routes;
-		};
+		json::Document HandleRequests(const json::Document& document, const std::function<void()>& handle_base_requests);
 
 		void HandleBaseRequests(const json::Document& document);
 		void HandleRenderRequests(const json::Document& json_document);
 		void HandleRoutingSettingsRequests(const json::Document& json_document);
 		json::Document HandleStatRequests(const json::Document& document) const;
 
-		void CatalogueDestinationsFilling(std::unordered_map<std::string_view, json::Dict>& stops_and_destinations);
+		void CatalogueDestinationsFilling(std::unordered_map<std::string_view, const json::Dict*>& stops_and_destinations);
 		void CatalogueBusesFilling(std::unordered_map<std::string_view, std::pair<std::vector<std::string_view>, bool>>& buses);
 
 		const svg::Color ChooseColor(const json::Node& to_process) const;
+		domain::RouterEngine ChooseRouterEngine(const json::Dict& routing_settings) const;
 		void ExtractSettings(const json::Document& document);
 
 		void ProcessMapRequest(const json::Dict& to_parse, json::Builder& builder) const;
 		void ProcessBusRequest(const json::Dict& to_parse, json::Builder& builder) const;
 		void ProcessStopRequest(const json::Dict& to_parse, json::Builder& builder) const;
 		void ProcessRouteRequest(const json::Dict& to_parse, json::Builder& builder) const;
+		void ProcessTravelTimeRequest(const json::Dict& to_parse, json::Builder& builder) const;
+		void ProcessRouterStatsRequest(const json::Dict& to_parse, json::Builder& builder) const;
 
 		void CatalogueStopsFilling(const json::Document& document, const CatalogueStopsFillingParameters& parameters);
-		void MakeStopDatabase(const json::Document& document, const MakeStopDatabaseParameters& parameters);
-		void MakeBusDatabase(const MakeBusDatabaseParameters& parameters);
 
 		catalogue::TransportCatalogue& database_;
 		map_renderer::MapRenderer& renderer_;
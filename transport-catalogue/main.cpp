@@ -1,17 +1,50 @@
 #include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
 
 #include "router.h"
 #include "json.h"
 #include "json_reader.h"
 // #include "log_duration.h"
 #include "map_renderer.h"
+#include "mapped_file.h"
 #include "transport_catalogue.h"
 
-int main() {
-    const json::Document document = json::Load(std::cin);
+namespace {
+    // Block reads: unsynchronized with stdio, the stream buffer copies whole chunks
+    std::string ReadAll(std::istream& input) {
+        std::string contents;
+        std::string chunk(std::size_t{ 1 } << 20, '\0');
+
+        while (input.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || input.gcount() > 0) {
+            contents.append(chunk.data(), static_cast<std::size_t>(input.gcount()));
+        }
+
+        return contents;
+    }
+} // unnamed namespace
+
+// Requests are read from the file given as the only argument, mapped into memory, or from stdin
+int main(int argc, char* argv[]) {
+    std::ios::sync_with_stdio(false);
+
+    std::optional<mapped_file::MappedFile> file;
+    std::string stdin_input;
+    std::string_view input;
+
+    if (argc > 1) {
+        input = file.emplace(argv[1]).GetView();
+    }
+    else {
+        stdin_input = ReadAll(std::cin);
+        input = stdin_input;
+    }
+
     catalogue::TransportCatalogue catalogue;
     map_renderer::MapRenderer map_renderer;
 
+    // Base requests are streamed into the catalogue, so the document of the whole input is never built
     json_reader::JsonReader reader(catalogue, map_renderer);
-    json::Print(reader.HandleRequests(document), std::cout);
-}
\ No newline at end of file
+    json::Print(reader.HandleRequests(input), std::cout);
+}
@@ -1,4 +1,5 @@
 #include <cstdlib>
+#include <numeric>
 #include <utility>
 
 #include "map_renderer.h"
@@ -35,16 +36,27 @@ namespace map_renderer {
         color_palette_ = std::move(color_palette);
     }
 
-    void MapRenderer::SetDequeStops(std::deque<domain::Stop>&& deque_stops) {
-        deque_stops_ = std::move(deque_stops);
+    void MapRenderer::SetSnapshot(const domain::Snapshot& snapshot) {
+        snapshot_ = &snapshot;
     }
 
-    void MapRenderer::SetSortedStops(std::set<std::string_view>&& sorted_stops) {
-        sorted_stops_ = std::move(sorted_stops);
-    }
+    void MapRenderer::SortRoutesAndStops() {
+        routes_.resize(snapshot_->GetBusCount());
+        std::iota(routes_.begin(), routes_.end(), domain::BusId{});
+        std::ranges::sort(routes_, {}, [this](domain::BusId bus) {
+            return snapshot_->bus_names[bus];
+        });
+
+        sorted_stops_.clear();
+        for (std::size_t stop = 0; stop < snapshot_->GetStopCount(); ++stop) {
+            if (!snapshot_->GetStopBuses(static_cast<domain::StopId>(stop)).empty()) {
+                sorted_stops_.push_back(static_cast<domain::StopId>(stop));
+            }
+        }
 
-    void MapRenderer::SetRoutes(std::deque<std::pair<domain::Bus, bool>>&& routes) {
-        routes_ = std::move(routes);
+        std::ranges::sort(sorted_stops_, {}, [this](domain::StopId stop) {
+            return snapshot_->stop_names[stop];
+        });
     }
 
 // 
@@ -59,11 +71,13 @@ namespace map_renderer {
         for (auto route = routes_.begin(); route != routes_.end(); ++route, ++color_to_be_applied) {
             auto current_color = color_to_be_applied % color_palette_.size();
 
-            if (route->first.stops_with_duplicates.size()) {
+            const std::span<const domain::StopId> stops = snapshot_->GetBusStops(*route);
+
+            if (stops.size()) {
                 std::vector<geo::Coordinates> geo_coordinates;
 
-                for (const auto& stop : route->first.stops_with_duplicates) {
-                    geo_coordinates.push_back(stop->coordinates);
+                for (const domain::StopId stop : stops) {
+                    geo_coordinates.push_back(snapshot_->GetCoordinates(stop));
                 }
 
                 svg::Polyline to_be_added;
@@ -93,16 +107,19 @@ namespace map_renderer {
         for (auto route = routes_.begin(); route != routes_.end(); ++route, ++color_to_be_applied) {
             auto current_color = color_to_be_applied % color_palette_.size();
 
-            if (route->first.stops_with_duplicates.size()) {
-                if (!route->second && route->first.stops_with_duplicates.front()->name != route->first.stops_with_duplicates.at(route->first.stops_with_duplicates.size() / 2)->name) {
-                    svg::Point screen_coordinate = sphere_projector(route->first.stops_with_duplicates.front()->coordinates);
+            const std::span<const domain::StopId> stops = snapshot_->GetBusStops(*route);
+            const std::string bus_name(snapshot_->bus_names[*route]);
+
+            if (stops.size()) {
+                if (!snapshot_->are_roundtrips[*route] && stops.front() != stops[stops.size() / 2]) {
+                    svg::Point screen_coordinate = sphere_projector(snapshot_->GetCoordinates(stops.front()));
 
                     svg::Text begin_underlayer_to_be_added;
                     begin_underlayer_to_be_added.SetOffset(settings_.bus_label_offset);
                     begin_underlayer_to_be_added.SetFontSize(settings_.bus_label_font_size);
                     begin_underlayer_to_be_added.SetFontFamily("Verdana"s);
                     begin_underlayer_to_be_added.SetFontWeight("bold"s);
-                    begin_underlayer_to_be_added.SetData(route->first.name);
+                    begin_underlayer_to_be_added.SetData(bus_name);
 
                     svg::Text begin_text_to_be_added = begin_underlayer_to_be_added;
 
@@ -118,7 +135,7 @@ namespace map_renderer {
                     begin_underlayer_to_be_added.SetPosition(screen_coordinate);
                     begin_text_to_be_added.SetPosition(screen_coordinate);
 
-                    screen_coordinate = sphere_projector(route->first.stops_with_duplicates.at(route->first.stops_with_duplicates.size() / 2)->coordinates);
+                    screen_coordinate = sphere_projector(snapshot_->GetCoordinates(stops[stops.size() / 2]));
                     end_underlayer_to_be_added.SetPosition(screen_coordinate);
                     end_text_to_be_added.SetPosition(screen_coordinate);
 
@@ -130,7 +147,7 @@ namespace map_renderer {
                     continue;
                 }
 
-                const svg::Point screen_coordinate = sphere_projector(route->first.stops_with_duplicates.front()->coordinates);
+                const svg::Point screen_coordinate = sphere_projector(snapshot_->GetCoordinates(stops.front()));
 
                 svg::Text underlayer_to_be_added;
                 underlayer_to_be_added.SetPosition(screen_coordinate);
@@ -138,7 +155,7 @@ namespace map_renderer {
                 underlayer_to_be_added.SetFontSize(settings_.bus_label_font_size);
                 underlayer_to_be_added.SetFontFamily("Verdana"s);
                 underlayer_to_be_added.SetFontWeight("bold"s);
-                underlayer_to_be_added.SetData(route->first.name);
+                underlayer_to_be_added.SetData(bus_name);
 
                 svg::Text text_to_be_added = underlayer_to_be_added;
 
@@ -164,7 +181,7 @@ namespace map_renderer {
         using namespace std::literals;
 
         for (const auto& stop : sorted_stops_) {
-            const svg::Point screen_coordinate = sphere_projector(std::find(deque_stops_.begin(), deque_stops_.end(), stop)->coordinates);
+            const svg::Point screen_coordinate = sphere_projector(snapshot_->GetCoordinates(stop));
 
             svg::Circle to_be_added;
             to_be_added.SetCenter(screen_coordinate);
@@ -184,15 +201,14 @@ namespace map_renderer {
         using namespace std::literals;
 
         for (const auto& stop : sorted_stops_) {
-            domain::Stop& stop_to_process = *std::find(deque_stops_.begin(), deque_stops_.end(), stop);
-            const svg::Point screen_coordinate = sphere_projector(stop_to_process.coordinates);
+            const svg::Point screen_coordinate = sphere_projector(snapshot_->GetCoordinates(stop));
 
             svg::Text underlayer_to_be_added;
             underlayer_to_be_added.SetPosition(screen_coordinate);
             underlayer_to_be_added.SetOffset(settings_.stop_label_offset);
             underlayer_to_be_added.SetFontSize(settings_.stop_label_font_size);
             underlayer_to_be_added.SetFontFamily("Verdana"s);
-            underlayer_to_be_added.SetData(stop_to_process.name);
+            underlayer_to_be_added.SetData(std::string(snapshot_->stop_names[stop]));
 
             svg::Text text_to_be_added = underlayer_to_be_added;
 
@@ -214,11 +230,11 @@ namespace map_renderer {
 // ---------------------------------------------------- Rendering Facade +
 
     svg::Document MapRenderer::RenderMap() {
+        SortRoutesAndStops();
+
         std::vector<geo::Coordinates> each_geo_coordinate;
-        for (const auto& route : routes_) {
-            for (const auto& stop : route.first.stops_with_duplicates) {
-                each_geo_coordinate.push_back(stop->coordinates);
-            }
+        for (const domain::StopId stop : snapshot_->bus_stops) {
+            each_geo_coordinate.push_back(snapshot_->GetCoordinates(stop));
         }
 
         detail::SphereProjector sphere_projector(each_geo_coordinate.begin(), each_geo_coordinate.end(), settings_.width, settings_.height, settings_.padding);
@@ -105,13 +105,13 @@ namespace map_renderer {
         
         void SetSettings(Settings&& settings);
         void SetColorPalette(std::vector<svg::Color>&& color_palette);
-        void SetDequeStops(std::deque<domain::Stop>&& deque_stops);
-        void SetSortedStops(std::set<std::string_view>&& sorted_stops);
-        void SetRoutes(std::deque<std::pair<domain::Bus, bool>>&& routes);
+        void SetSnapshot(const domain::Snapshot& snapshot);
 
         svg::Document RenderMap();
 
 	private:
+        void SortRoutesAndStops();
+
         void RenderLines(const detail::SphereProjector& sphere_projector);
         void RenderLineText(const detail::SphereProjector& sphere_projector);
         void RenderCircles(const detail::SphereProjector& sphere_projector);
@@ -120,9 +120,11 @@ namespace map_renderer {
         Settings settings_;
         std::vector<svg::Color> color_palette_;
 
-        std::deque<domain::Stop> deque_stops_;
-        std::set<std::string_view> sorted_stops_;    
-        std::deque<std::pair<domain::Bus, bool>> routes_;
+        const domain::Snapshot* snapshot_ = nullptr;
+
+        // Buses and the stops served by them, sorted by name
+        std::vector<domain::BusId> routes_;
+        std::vector<domain::StopId> sorted_stops_;
 
         svg::Document svgs_to_be_rendered_;
 	};
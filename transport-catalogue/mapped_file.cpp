@@ -0,0 +1,86 @@
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_HAS_MMAP 1
+#endif
+
+#include "mapped_file.h"
+
+namespace mapped_file {
+// ------------ [Mapped File] Realization ------------
+//                                                   +
+//                                                   + -------------
+// --------------------------------------------------- Mapped File +
+
+#if defined(MAPPED_FILE_HAS_MMAP)
+    MappedFile::MappedFile(const std::string& path) {
+        const int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor == -1) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+
+        struct stat status {};
+        if (fstat(descriptor, &status) == -1) {
+            const int error = errno;
+            close(descriptor);
+            throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+        }
+
+        size_ = static_cast<std::size_t>(status.st_size);
+
+        // Empty files can't be mapped and need no view
+        if (size_ == 0) {
+            close(descriptor);
+            return;
+        }
+
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        const int error = errno;
+        close(descriptor);
+
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+        }
+
+        // The parser reads the file once from start to end. Advice is a hint, so its failures are ignored
+        madvise(mapping, size_, MADV_SEQUENTIAL);
+        madvise(mapping, size_, MADV_WILLNEED);
+#if defined(MADV_HUGEPAGE)
+        madvise(mapping, size_, MADV_HUGEPAGE);
+#endif
+
+        data_ = static_cast<const char*>(mapping);
+        is_mapped_ = true;
+    }
+
+    MappedFile::~MappedFile() {
+        if (is_mapped_) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& path) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input) {
+            throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), "Cannot open " + path);
+        }
+
+        contents_.assign(std::istreambuf_iterator<char>(input), {});
+        data_ = contents_.data();
+        size_ = contents_.size();
+    }
+
+    MappedFile::~MappedFile() = default;
+#endif
+
+    std::string_view MappedFile::GetView() const {
+        return { data_, size_ };
+    }
+} // namespace mapped_file
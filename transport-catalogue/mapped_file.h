@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace mapped_file {
+// ------------ [Mapped File] Definition ------------
+//                                                  +
+//                                                  + -------------
+// -------------------------------------------------- Mapped File +
+
+    // Read-only view of a whole file. On POSIX systems the file is memory-mapped with sequential
+    // read-ahead advice, elsewhere it is read into memory. The view lives as long as the object
+    class MappedFile final {
+    public:
+        explicit MappedFile(const std::string& path);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        std::string_view GetView() const;
+
+    private:
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+        bool is_mapped_ = false;
+        std::string contents_;
+    };
+} // namespace mapped_file
@@ -0,0 +1,220 @@
+#include <algorithm>
+
+#include "raptor_router.h"
+
+namespace transport_router {
+// ------------ [Raptor Router] Realization ------------
+//                                                     +
+//                                                     + -----------------
+// ----------------------------------------------------- Building trips +
+
+	RaptorRouter::RaptorRouter(const catalogue::TransportCatalogue& database, const domain::RoutingSettings& routing_settings)
+		: bus_wait_time_(routing_settings.bus_wait_time * 1.0)
+		, bus_velocity_(routing_settings.bus_velocity)
+		, trip_offsets_{ 0 } {
+
+		const domain::Snapshot& snapshot = database.GetSnapshot();
+
+		for (domain::BusId bus = 0; bus < snapshot.GetBusCount(); ++bus) {
+			const std::span<const domain::StopId> stops = snapshot.GetBusStops(bus);
+			const std::span<const std::uint32_t> segments = database.GetSegmentDistances(bus);
+
+			if (stops.size() < 2) {
+				continue;
+			}
+
+			// A linear bus is ridden as two trips meeting at its terminal stop
+			if (!snapshot.are_roundtrips[bus]) {
+				const std::size_t terminal = stops.size() / 2;
+				AddTrip(bus, stops.first(terminal + 1), segments.first(terminal));
+				AddTrip(bus, stops.subspan(terminal), segments.subspan(terminal));
+			}
+			else {
+				AddTrip(bus, stops, segments);
+			}
+		}
+
+		IndexStopTrips(snapshot.GetStopCount());
+	}
+
+	void RaptorRouter::AddTrip(domain::BusId bus, std::span<const domain::StopId> stops, std::span<const std::uint32_t> segments) {
+		std::uint64_t distance = 0;
+
+		for (std::size_t position = 0; position < stops.size(); ++position) {
+			trip_stops_.push_back(stops[position]);
+			trip_distances_.push_back(distance);
+
+			if (position < segments.size()) {
+				distance += segments[position];
+			}
+		}
+
+		trip_buses_.push_back(bus);
+		trip_offsets_.push_back(static_cast<std::uint32_t>(trip_stops_.size()));
+	}
+
+	// Last stops of the trips are not indexed: nobody boards there
+	void RaptorRouter::IndexStopTrips(std::size_t stop_count) {
+		stop_trip_offsets_.assign(stop_count + 1, 0);
+
+		for (std::uint32_t trip = 0; trip < trip_buses_.size(); ++trip) {
+			for (std::uint32_t index = trip_offsets_[trip]; index + 1 < trip_offsets_[trip + 1]; ++index) {
+				++stop_trip_offsets_[trip_stops_[index] + 1];
+			}
+		}
+
+		for (std::size_t stop = 0; stop < stop_count; ++stop) {
+			stop_trip_offsets_[stop + 1] += stop_trip_offsets_[stop];
+		}
+
+		std::vector<std::uint32_t> ends(stop_trip_offsets_.begin(), stop_trip_offsets_.end() - 1);
+		stop_trips_.resize(stop_trip_offsets_.back());
+
+		for (std::uint32_t trip = 0; trip < trip_buses_.size(); ++trip) {
+			for (std::uint32_t index = trip_offsets_[trip]; index + 1 < trip_offsets_[trip + 1]; ++index) {
+				stop_trips_[ends[trip_stops_[index]]++] = TripStop{ trip, index - trip_offsets_[trip] };
+			}
+		}
+	}
+
+//
+//
+//                                                     + ---------
+// ----------------------------------------------------- Rounds +
+
+	void RaptorRouter::Workspace::Prepare(std::size_t stop_count, std::size_t trip_count) {
+		times.assign(stop_count, INFINITE_TIME);
+		parents.resize(stop_count);
+		are_marked.assign(stop_count, false);
+		marked_stops.clear();
+		first_positions.assign(trip_count, NO_POSITION);
+		queued_trips.clear();
+	}
+
+	RaptorRouter::Workspace& RaptorRouter::GetWorkspace() {
+		thread_local Workspace workspace;
+		return workspace;
+	}
+
+	std::optional<domain::Route> RaptorRouter::BuildRoute(domain::StopId from, domain::StopId to) const {
+		if (from == to) {
+			return domain::Route{};
+		}
+
+		Workspace& workspace = GetWorkspace();
+		workspace.Prepare(stop_trip_offsets_.size() - 1, trip_buses_.size());
+
+		workspace.times[from] = 0.0;
+		workspace.are_marked[from] = true;
+		workspace.marked_stops.push_back(from);
+
+		while (!workspace.marked_stops.empty()) {
+			QueueTrips(workspace);
+
+			for (const std::uint32_t trip : workspace.queued_trips) {
+				ScanTrip(workspace, trip, to);
+				workspace.first_positions[trip] = NO_POSITION;
+			}
+
+			workspace.queued_trips.clear();
+		}
+
+		if (workspace.times[to] == INFINITE_TIME) {
+			return std::nullopt;
+		}
+
+		return RestoreRoute(workspace, from, to);
+	}
+
+	// Every trip is ridden once per round, starting from its earliest improved stop
+	void RaptorRouter::QueueTrips(Workspace& workspace) const {
+		for (const domain::StopId stop : workspace.marked_stops) {
+			workspace.are_marked[stop] = false;
+
+			for (std::uint32_t index = stop_trip_offsets_[stop]; index < stop_trip_offsets_[stop + 1]; ++index) {
+				const TripStop& trip_stop = stop_trips_[index];
+				std::uint32_t& first_position = workspace.first_positions[trip_stop.trip];
+
+				if (first_position == NO_POSITION) {
+					workspace.queued_trips.push_back(trip_stop.trip);
+				}
+
+				first_position = std::min(first_position, trip_stop.position);
+			}
+		}
+
+		workspace.marked_stops.clear();
+	}
+
+	void RaptorRouter::ScanTrip(Workspace& workspace, std::uint32_t trip, domain::StopId to) const {
+		const std::uint32_t trip_begin = trip_offsets_[trip];
+		const std::uint32_t trip_end = trip_offsets_[trip + 1];
+
+		std::uint32_t board_index = NO_POSITION;
+		double board_time = INFINITE_TIME;
+
+		for (std::uint32_t index = trip_begin + workspace.first_positions[trip]; index < trip_end; ++index) {
+			const domain::StopId stop = trip_stops_[index];
+			double ride_time = INFINITE_TIME;
+
+			if (board_index != NO_POSITION) {
+				ride_time = board_time + (bus_wait_time_ + ComputeRideTime(board_index, index));
+
+				if (ride_time < workspace.times[stop] && ride_time < workspace.times[to]) {
+					workspace.times[stop] = ride_time;
+					workspace.parents[stop] = Parent{ trip, board_index - trip_begin, index - trip_begin };
+
+					if (!workspace.are_marked[stop]) {
+						workspace.are_marked[stop] = true;
+						workspace.marked_stops.push_back(stop);
+					}
+				}
+			}
+
+			// Staying on board wins ties, so routes keep fewer transfers. The wait joins the ride before
+			// the arrival time is added, in the order the graph engines sum their edge weights
+			if (workspace.times[stop] + bus_wait_time_ < ride_time) {
+				board_index = index;
+				board_time = workspace.times[stop];
+			}
+		}
+	}
+
+	double RaptorRouter::ComputeRideTime(std::uint32_t board_index, std::uint32_t alight_index) const {
+		const double length = static_cast<double>(trip_distances_[alight_index] - trip_distances_[board_index]);
+		return length / 1000.0 / bus_velocity_ * 60;
+	}
+
+//
+//
+//                                                     + ----------------
+// ----------------------------------------------------- Restoring route +
+
+	domain::Route RaptorRouter::RestoreRoute(const Workspace& workspace, domain::StopId from, domain::StopId to) const {
+		domain::Route route{ .total_time = workspace.times[to], .items = {} };
+
+		for (domain::StopId stop = to; stop != from;) {
+			const Parent& parent = workspace.parents[stop];
+			const std::uint32_t trip_begin = trip_offsets_[parent.trip];
+			const domain::StopId board_stop = trip_stops_[trip_begin + parent.board_position];
+
+			route.items.push_back(domain::RouteItem{
+				.type = domain::RouteItem::Type::BUS,
+				.bus = trip_buses_[parent.trip],
+				.span_count = parent.alight_position - parent.board_position,
+				.time = ComputeRideTime(trip_begin + parent.board_position, trip_begin + parent.alight_position)
+			});
+
+			route.items.push_back(domain::RouteItem{
+				.type = domain::RouteItem::Type::WAIT,
+				.stop = board_stop,
+				.time = bus_wait_time_
+			});
+
+			stop = board_stop;
+		}
+
+		std::reverse(route.items.begin(), route.items.end());
+		return route;
+	}
+} // namespace transport_router
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "domain.h"
+#include "transport_catalogue.h"
+
+namespace transport_router {
+// ------------ [Raptor Router] Definition ------------
+//                                                    +
+//                                                    + ---------------
+// ---------------------------------------------------- Raptor Router +
+
+	// Round-based engine working on the buses' stop sequences directly, without the span graph.
+	// Every round rides the trips passing through the stops improved by the previous one.
+	// Memory is linear in the total route length
+	class RaptorRouter final {
+	public:
+		RaptorRouter(const catalogue::TransportCatalogue& database, const domain::RoutingSettings& routing_settings);
+
+		std::optional<domain::Route> BuildRoute(domain::StopId from, domain::StopId to) const;
+
+	private:
+		struct TripStop final {
+			std::uint32_t trip;
+			std::uint32_t position;
+		};
+
+		// The best time of a stop was reached by riding [trip] from [board_position] to [alight_position]
+		struct Parent final {
+			std::uint32_t trip;
+			std::uint32_t board_position;
+			std::uint32_t alight_position;
+		};
+
+		struct Workspace final {
+			std::vector<double> times;
+			std::vector<Parent> parents;
+			std::vector<std::uint8_t> are_marked;
+			std::vector<domain::StopId> marked_stops;
+			std::vector<std::uint32_t> first_positions;
+			std::vector<std::uint32_t> queued_trips;
+
+			void Prepare(std::size_t stop_count, std::size_t trip_count);
+		};
+
+		void AddTrip(domain::BusId bus, std::span<const domain::StopId> stops, std::span<const std::uint32_t> segments);
+		void IndexStopTrips(std::size_t stop_count);
+
+		void QueueTrips(Workspace& workspace) const;
+		void ScanTrip(Workspace& workspace, std::uint32_t trip, domain::StopId to) const;
+		domain::Route RestoreRoute(const Workspace& workspace, domain::StopId from, domain::StopId to) const;
+		double ComputeRideTime(std::uint32_t board_index, std::uint32_t alight_index) const;
+
+		static Workspace& GetWorkspace();
+
+		static constexpr double INFINITE_TIME = std::numeric_limits<double>::infinity();
+		static constexpr std::uint32_t NO_POSITION = std::numeric_limits<std::uint32_t>::max();
+
+		double bus_wait_time_;
+		double bus_velocity_;
+
+		// Stops of trip [t]: [trip_offsets_[t], trip_offsets_[t + 1]) of trip_stops_,
+		// trip_distances_ holds the road distance from the trip's first stop
+		std::vector<domain::BusId> trip_buses_;
+		std::vector<std::uint32_t> trip_offsets_;
+		std::vector<domain::StopId> trip_stops_;
+		std::vector<std::uint64_t> trip_distances_;
+
+		// Trips passing through stop [id]: [stop_trip_offsets_[id], stop_trip_offsets_[id + 1]) of stop_trips_
+		std::vector<std::uint32_t> stop_trip_offsets_;
+		std::vector<TripStop> stop_trips_;
+	};
+} // namespace transport_router
@@ -10,23 +10,36 @@
 #include <utility>
 #include <vector>
 
+#include "csr_graph.h"
 #include "graph.h"
 
 namespace graph {
+    // Common interface of the routing engines: every engine answers point-to-point queries
+    // with the total weight and the ids of the graph edges along the optimal route
     template <typename Weight>
-    class Router {
-    private:
-        using Graph = DirectedWeightedGraph<Weight>;
-
+    class RoutingEngine {
     public:
-        explicit Router(const Graph& graph);
-
         struct RouteInfo {
             Weight weight;
             std::vector<EdgeId> edges;
         };
 
-        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+        virtual std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const = 0;
+        virtual ~RoutingEngine() = default;
+    };
+
+    // All-pairs engine: Floyd-Warshall in the constructor, O(V^2) memory, O(route length) queries
+    template <typename Weight>
+    class Router final : public RoutingEngine<Weight> {
+    private:
+        using Graph = CsrGraph<Weight>;
+
+    public:
+        using typename RoutingEngine<Weight>::RouteInfo;
+
+        explicit Router(const Graph& graph);
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const override;
 
     private:
         struct RouteInternalData {
@@ -41,16 +54,14 @@ namespace graph {
             for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
                 routes_internal_data_[vertex][vertex] = RouteInternalData{ ZERO_WEIGHT, std::nullopt };
 
-                for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
-                    const auto& edge = graph.GetEdge(edge_id);
-
+                for (const auto& edge : graph.GetOutgoingEdges(vertex)) {
                     if (edge.weight < ZERO_WEIGHT) {
                         throw std::domain_error("Edges' weights should be non-negative");
                     }
 
                     auto& route_internal_data = routes_internal_data_[vertex][edge.to];
                     if (!route_internal_data || route_internal_data->weight > edge.weight) {
-                        route_internal_data = RouteInternalData{ edge.weight, edge_id };
+                        route_internal_data = RouteInternalData{ edge.weight, edge.id };
                     }
                 }
             }
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.h"
+#include "dijkstra_router.h"
+#include "graph.h"
+#include "router.h"
+
+namespace graph {
+// ------------ [Row Cache Router] Definition ------------
+//                                                       +
+//                                                       + ------------------
+// ------------------------------------------------------- Row Cache Router +
+
+    // Lazy all-pairs engine: the single-source row of a vertex (weights and predecessor edges) is computed
+    // by a full Dijkstra search on the first query from it and kept in an LRU cache bounded by [memory_budget]
+    // bytes. Queries from a cached source are path walks. At least one row is always kept
+    template <typename Weight>
+    class RowCacheRouter final : public RoutingEngine<Weight> {
+    private:
+        using Graph = CsrGraph<Weight>;
+        using PrevEdge = std::uint32_t;
+
+    public:
+        using typename RoutingEngine<Weight>::RouteInfo;
+
+        struct CacheStats final {
+            std::size_t hits = 0;
+            std::size_t misses = 0;
+            std::size_t evictions = 0;
+            std::size_t row_capacity = 0;
+        };
+
+        RowCacheRouter(const Graph& graph, std::size_t memory_budget);
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const override;
+
+        CacheStats GetCacheStats() const;
+
+    private:
+        struct Row final {
+            std::vector<Weight> weights;
+            std::vector<PrevEdge> prev_edges;
+        };
+
+        using RowPtr = std::shared_ptr<const Row>;
+        using RowList = std::list<std::pair<VertexId, RowPtr>>;
+
+        RowPtr GetRow(VertexId source) const;
+        RowPtr ComputeRow(VertexId source) const;
+
+        static constexpr Weight ZERO_WEIGHT{};
+        static constexpr Weight INFINITE_WEIGHT = std::numeric_limits<Weight>::has_infinity
+            ? std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::max();
+        static constexpr PrevEdge NO_PREV_EDGE = std::numeric_limits<PrevEdge>::max();
+
+        const Graph& graph_;
+        std::size_t row_capacity_;
+
+        // Rows are shared, so a row evicted by one thread stays valid for the walk of another one
+        mutable std::mutex mutex_;
+        mutable RowList rows_;
+        mutable std::unordered_map<VertexId, typename RowList::iterator> row_positions_;
+
+        mutable std::atomic<std::size_t> hits_ = 0;
+        mutable std::atomic<std::size_t> misses_ = 0;
+        mutable std::atomic<std::size_t> evictions_ = 0;
+    };
+
+// ------------ [Row Cache Router] Realization ------------
+//                                                        +
+//                                                        + ------------------
+// -------------------------------------------------------- Row Cache Router +
+
+    template <typename Weight>
+    RowCacheRouter<Weight>::RowCacheRouter(const Graph& graph, std::size_t memory_budget)
+        : graph_(graph) {
+
+        if (graph.GetEdgeCount() >= NO_PREV_EDGE) {
+            throw std::length_error("Too many edges for 32-bit predecessors");
+        }
+
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            if (graph.GetEdge(edge_id).weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+        }
+
+        const std::size_t row_size = std::max<std::size_t>(graph.GetVertexCount() * (sizeof(Weight) + sizeof(PrevEdge)), 1);
+        row_capacity_ = std::max<std::size_t>(memory_budget / row_size, 1);
+    }
+
+    template <typename Weight>
+    std::optional<typename RowCacheRouter<Weight>::RouteInfo> RowCacheRouter<Weight>::BuildRoute(VertexId from,
+        VertexId to) const {
+        const RowPtr row = GetRow(from);
+
+        if (row->weights[to] == INFINITE_WEIGHT) {
+            return std::nullopt;
+        }
+
+        std::vector<EdgeId> edges;
+        for (PrevEdge edge_id = row->prev_edges[to]; edge_id != NO_PREV_EDGE;
+            edge_id = row->prev_edges[graph_.GetEdge(edge_id).from])
+        {
+            edges.push_back(edge_id);
+        }
+
+        std::reverse(edges.begin(), edges.end());
+        return RouteInfo{ row->weights[to], std::move(edges) };
+    }
+
+    template <typename Weight>
+    typename RowCacheRouter<Weight>::CacheStats RowCacheRouter<Weight>::GetCacheStats() const {
+        return CacheStats{ .hits = hits_.load(), .misses = misses_.load(), .evictions = evictions_.load(),
+            .row_capacity = row_capacity_ };
+    }
+
+//
+//
+//                                                        + ------------
+// -------------------------------------------------------- Row Cache +
+
+    // The search runs outside the lock; if another thread computed the same row meanwhile, its row is kept
+    template <typename Weight>
+    typename RowCacheRouter<Weight>::RowPtr RowCacheRouter<Weight>::GetRow(VertexId source) const {
+        {
+            std::lock_guard guard(mutex_);
+
+            if (const auto position = row_positions_.find(source); position != row_positions_.end()) {
+                rows_.splice(rows_.begin(), rows_, position->second);
+                ++hits_;
+                return position->second->second;
+            }
+        }
+
+        ++misses_;
+        RowPtr row = ComputeRow(source);
+
+        std::lock_guard guard(mutex_);
+
+        if (const auto position = row_positions_.find(source); position != row_positions_.end()) {
+            rows_.splice(rows_.begin(), rows_, position->second);
+            return position->second->second;
+        }
+
+        if (rows_.size() == row_capacity_) {
+            row_positions_.erase(rows_.back().first);
+            rows_.pop_back();
+            ++evictions_;
+        }
+
+        rows_.emplace_front(source, row);
+        row_positions_.emplace(source, rows_.begin());
+        return row;
+    }
+
+    template <typename Weight>
+    typename RowCacheRouter<Weight>::RowPtr RowCacheRouter<Weight>::ComputeRow(VertexId source) const {
+        auto row = std::make_shared<Row>();
+        row->weights.assign(graph_.GetVertexCount(), INFINITE_WEIGHT);
+        row->prev_edges.assign(graph_.GetVertexCount(), NO_PREV_EDGE);
+
+        detail::SearchQueue<Weight> queue;
+        row->weights[source] = ZERO_WEIGHT;
+        queue.Push(ZERO_WEIGHT, source);
+
+        while (!queue.IsEmpty()) {
+            const auto [weight, vertex] = queue.Pop();
+
+            if (weight > row->weights[vertex]) {
+                continue;
+            }
+
+            for (const auto& edge : graph_.GetOutgoingEdges(vertex)) {
+                const Weight candidate_weight = weight + edge.weight;
+
+                if (candidate_weight < row->weights[edge.to]) {
+                    row->weights[edge.to] = candidate_weight;
+                    row->prev_edges[edge.to] = static_cast<PrevEdge>(edge.id);
+                    queue.Push(candidate_weight, edge.to);
+                }
+            }
+        }
+
+        return row;
+    }
+} // namespace graph
@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
 #include "transport_catalogue.h"
 
 namespace catalogue {
@@ -6,36 +12,204 @@ namespace catalogue {
 //                                                           + ----------------
 // ----------------------------------------------------------- Adding methods +
 
-	void TransportCatalogue::AddStop(const std::string& stop, const geo::Coordinates& coordinates) {
-		deque_stops_.emplace_back(stop, coordinates);
-		stops_[deque_stops_.back().name];
+	void TransportCatalogue::AddStop(std::string_view stop, const geo::Coordinates& coordinates) {
+		deque_stops_.emplace_back(StoreName(stop), coordinates, static_cast<domain::StopId>(deque_stops_.size()));
+		stop_index_[deque_stops_.back().name] = &deque_stops_.back();
+		stop_buses_.emplace_back();
 	}
 
-	void TransportCatalogue::AddDestination(const std::string& stop, const std::string& dst, 
+	void TransportCatalogue::AddDestination(std::string_view stop, std::string_view dst, 
 		const std::size_t length) {
 
-		domain::Stop* stop_to_process = FindStop(stop);
-		domain::Stop* dst_to_process = FindStop(dst);
-		destinations_[{ stop_to_process->name, dst_to_process->name }] = length;
+		using namespace std::literals;
+		const domain::Stop* from = FindStop(stop);
+		const domain::Stop* to = FindStop(dst);
 
-		if (!destinations_.contains(std::make_pair(dst_to_process->name, stop_to_process->name))) {
-			destinations_[{ dst_to_process->name, stop_to_process->name }] = length;
+		if (from == nullptr || to == nullptr) {
+			throw std::invalid_argument("Unknown stop '"s + std::string(from == nullptr ? stop : dst)
+				+ "' in road_distances of stop '"s + std::string(stop) + "'"s);
 		}
+
+		AddDestination(from->id, to->id, length);
+	}
+
+	// The reverse distance is implied until it is given explicitly
+	void TransportCatalogue::AddDestination(domain::StopId stop, domain::StopId dst, const std::size_t length) {
+		destinations_[{ stop, dst }] = length;
+		destinations_.try_emplace({ dst, stop }, length);
 	}
 
-	void TransportCatalogue::AddBus(const std::string& bus, std::span<const std::string_view> proper_stops, 
+	void TransportCatalogue::AddBus(std::string_view bus, std::span<const std::string_view> proper_stops, 
 		bool is_roundtrip) {
 
-		deque_buses_.emplace_back(bus, std::vector<domain::Stop*>{}, is_roundtrip);
-		domain::Bus* bus_to_process = &deque_buses_.back();
+		std::vector<domain::StopId> stop_ids;
+		stop_ids.reserve(proper_stops.size());
 
 		for (const auto& stop : proper_stops) {
-			stops_.at(stop).insert(bus_to_process);
+			const domain::Stop* found = FindStop(stop);
+			if (found == nullptr) {
+				using namespace std::literals;
+				throw std::invalid_argument("Unknown stop '"s + std::string(stop) + "' in stops of bus '"s + std::string(bus) + "'"s);
+			}
+
+			stop_ids.push_back(found->id);
+		}
+
+		AddBus(bus, stop_ids, is_roundtrip);
+	}
+
+	void TransportCatalogue::AddBus(std::string_view bus, std::span<const domain::StopId> proper_stops, 
+		bool is_roundtrip) {
+
+		deque_buses_.emplace_back(StoreName(bus), std::vector<domain::Stop*>{}, is_roundtrip, static_cast<domain::BusId>(deque_buses_.size()));
+		domain::Bus* bus_to_process = &deque_buses_.back();
+		bus_index_[bus_to_process->name] = bus_to_process;
+		bus_to_process->stops_with_duplicates.reserve(proper_stops.size());
+
+		std::vector<domain::StopId> unique_stops(proper_stops.begin(), proper_stops.end());
+
+		for (domain::StopId stop : proper_stops) {
+			bus_to_process->stops_with_duplicates.push_back(&deque_stops_[stop]);
+		}
+
+		std::ranges::sort(unique_stops);
+		unique_stops.erase(std::ranges::unique(unique_stops).begin(), unique_stops.end());
+		unique_stops_.push_back(unique_stops.size());
+
+		for (domain::StopId stop : unique_stops) {
+			stop_buses_[stop].push_back(bus_to_process->id);
+		}
+	}
+
+	std::string_view TransportCatalogue::StoreName(std::string_view name) {
+		char* stored = static_cast<char*>(names_.allocate(name.size(), alignof(char)));
+		std::copy(name.begin(), name.end(), stored);
+		return { stored, name.size() };
+	}
+
+//
+// 
+//                                                           + ----------
+// ----------------------------------------------------------- Freezing +
+
+	void TransportCatalogue::Freeze() {
+		BuildSnapshot();
+		PackDistances();
+		bus_infos_.resize(deque_buses_.size());
+
+		const std::size_t buses_per_thread = 256;
+		const std::size_t thread_count = std::clamp<std::size_t>(deque_buses_.size() / buses_per_thread, 1,
+			std::max(1U, std::thread::hardware_concurrency()));
+		const std::size_t chunk_size = (deque_buses_.size() + thread_count - 1) / thread_count;
+
+		const geo::PointsTrigonometry stops_trigonometry = geo::ComputeTrigonometry(snapshot_.latitudes, snapshot_.longitudes);
+
+		auto compute_chunk = [this, chunk_size, &stops_trigonometry](std::size_t chunk) {
+			const std::size_t end = std::min(deque_buses_.size(), (chunk + 1) * chunk_size);
+
+			for (std::size_t bus = chunk * chunk_size; bus < end; ++bus) {
+				bus_infos_[bus] = ComputeFrozenBusInfo(static_cast<domain::BusId>(bus), stops_trigonometry);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (std::size_t chunk = 1; chunk < thread_count; ++chunk) {
+			threads.emplace_back(compute_chunk, chunk);
+		}
+
+		compute_chunk(0);
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		stop_buses_ = {};
+		is_frozen_ = true;
+	}
+
+	void TransportCatalogue::BuildSnapshot() {
+		snapshot_ = {};
+		snapshot_.stop_names.reserve(deque_stops_.size());
+		snapshot_.latitudes.reserve(deque_stops_.size());
+		snapshot_.longitudes.reserve(deque_stops_.size());
+
+		for (const domain::Stop& stop : deque_stops_) {
+			snapshot_.stop_names.push_back(stop.name);
+			snapshot_.latitudes.push_back(stop.coordinates.lat);
+			snapshot_.longitudes.push_back(stop.coordinates.lng);
+		}
+
+		snapshot_.bus_names.reserve(deque_buses_.size());
+		snapshot_.are_roundtrips.reserve(deque_buses_.size());
+		snapshot_.bus_stop_offsets.reserve(deque_buses_.size() + 1);
+		snapshot_.bus_stop_offsets.push_back(0);
+
+		for (const domain::Bus& bus : deque_buses_) {
+			snapshot_.bus_names.push_back(bus.name);
+			snapshot_.are_roundtrips.push_back(bus.is_roundtrip);
+
+			for (const domain::Stop* stop : bus.stops_with_duplicates) {
+				snapshot_.bus_stops.push_back(stop->id);
+			}
+
+			snapshot_.bus_stop_offsets.push_back(static_cast<std::uint32_t>(snapshot_.bus_stops.size()));
+		}
+
+		snapshot_.stop_bus_offsets.reserve(deque_stops_.size() + 1);
+		snapshot_.stop_bus_offsets.push_back(0);
+
+		for (std::vector<domain::BusId>& buses : stop_buses_) {
+			std::ranges::sort(buses, {}, [this](domain::BusId bus) -> std::string_view {
+				return deque_buses_[bus].name;
+			});
+
+			snapshot_.stop_buses.insert(snapshot_.stop_buses.end(), buses.begin(), buses.end());
+			snapshot_.stop_bus_offsets.push_back(static_cast<std::uint32_t>(snapshot_.stop_buses.size()));
+		}
+	}
+
+	void TransportCatalogue::PackDistances() {
+		distance_offsets_.assign(deque_stops_.size() + 1, 0);
+		for (const auto& [stops, length] : destinations_) {
+			++distance_offsets_[stops.first + 1];
+		}
+
+		std::partial_sum(distance_offsets_.begin(), distance_offsets_.end(), distance_offsets_.begin());
+
+		std::vector<std::pair<domain::StopId, std::uint32_t>> row_entries(destinations_.size());
+		std::vector<std::uint32_t> row_ends(distance_offsets_.begin(), distance_offsets_.end() - 1);
+
+		for (const auto& [stops, length] : destinations_) {
+			row_entries[row_ends[stops.first]++] = { stops.second, static_cast<std::uint32_t>(length) };
+		}
+
+		distance_targets_.resize(row_entries.size());
+		distance_lengths_.resize(row_entries.size());
+
+		for (std::size_t stop = 0; stop < deque_stops_.size(); ++stop) {
+			auto row_begin = row_entries.begin() + distance_offsets_[stop];
+			auto row_end = row_entries.begin() + distance_offsets_[stop + 1];
+			std::sort(row_begin, row_end);
+
+			for (auto it = row_begin; it != row_end; ++it) {
+				distance_targets_[it - row_entries.begin()] = it->first;
+				distance_lengths_[it - row_entries.begin()] = it->second;
+			}
+		}
+
+		are_distances_packed_ = true;
+		destinations_ = {};
+
+		segment_offsets_.assign(1, 0);
+		segment_distances_.clear();
 
-			domain::Stop* stop_to_process = FindStop(stop);
-			buses_[bus_to_process->name].insert(stop_to_process);
+		for (std::size_t bus = 0; bus < snapshot_.GetBusCount(); ++bus) {
+			const std::span<const domain::StopId> stops = snapshot_.GetBusStops(static_cast<domain::BusId>(bus));
 
-			FindBus(bus)->stops_with_duplicates.push_back(stop_to_process);
+			for (std::size_t stop = 1; stop < stops.size(); ++stop) {
+				segment_distances_.push_back(static_cast<std::uint32_t>(GetDistance(stops[stop - 1], stops[stop])));
+			}
+
+			segment_offsets_.push_back(static_cast<std::uint32_t>(segment_distances_.size()));
 		}
 	}
 
@@ -45,102 +219,113 @@ namespace catalogue {
 // ----------------------------------------------------------- Retrieving methods +
 
 	domain::Bus* TransportCatalogue::FindBus(std::string_view bus) {
-		return &*std::ranges::find(deque_buses_, bus, [](const domain::Bus& bus) {
-			return bus.name;
-		});
+		auto it = bus_index_.find(bus);
+		return it != bus_index_.end() ? it->second : nullptr;
 	}
 
 	domain::Stop* TransportCatalogue::FindStop(std::string_view stop) {
-		return &*std::ranges::find(deque_stops_, stop, [](const domain::Stop& range_stop) {
-			return range_stop.name;
-		});
+		auto it = stop_index_.find(stop);
+		return it != stop_index_.end() ? it->second : nullptr;
 	}
 
 	const domain::BusInfo TransportCatalogue::GetBusInfo(std::string_view bus) const {
-		using namespace std::literals;
-
-		domain::BusInfo to_output;
-		std::optional<const std::vector<domain::Stop*>*> to_deem = GetStopsForBus(bus);
+		std::optional<const domain::Bus*> to_deem = FindBus(bus);
 
 		if (!to_deem.has_value()) {
+			domain::BusInfo to_output;
 			to_output.name = bus;
 			return to_output;
 		}
 
-		to_output.name = bus;
-		to_output.stops_on_route = to_deem.value()->size();
-		to_output.unique_stops = ReturnAmoutOfUniqueStopsForBus(bus);
-
-		to_output.actual_distance = ComputeActualLength(bus);
-		to_output.pure_distance = ComputePureLength(bus);
-		to_output.curvature = to_output.actual_distance / to_output.pure_distance;
+		if (is_frozen_) {
+			return bus_infos_[to_deem.value()->id];
+		}
 
-		to_output.is_found = true;
-		return to_output;
+		return ComputeBusInfo(*to_deem.value());
 	}
 
 	const domain::StopInfo TransportCatalogue::GetStopInfo(std::string_view stop) const {
 		using namespace std::literals;
 
 		domain::StopInfo to_output;
-		const std::optional<const std::set<domain::Bus*, domain::Compartor>*> to_deem = GetBusesForStop(stop);
+		const std::optional<const domain::Stop*> to_deem = FindStop(stop);
+		to_output.name = stop;
 
 		if (!to_deem.has_value()) {
-			to_output.name = stop;
 			return to_output;
 		}
-		else if (!to_deem.value()->size()) {
-			to_output.name = stop;
-			to_output.is_found = true;
-			return to_output;
+
+		if (is_frozen_) {
+			for (domain::BusId bus : snapshot_.GetStopBuses(to_deem.value()->id)) {
+				to_output.bus_names.push_back(snapshot_.bus_names[bus]);
+			}
 		}
+		else {
+			for (domain::BusId bus : stop_buses_[to_deem.value()->id]) {
+				to_output.bus_names.push_back(deque_buses_[bus].name);
+			}
 
-		to_output.name = stop;
-		for (const auto& bus : *to_deem.value()) {
-			to_output.bus_names.push_back(bus->name);
+			std::ranges::sort(to_output.bus_names);
 		}
-		to_output.is_found = true;
 
+		to_output.is_found = true;
 		return to_output;
 	}
 
-	const std::deque<domain::Stop>& TransportCatalogue::GetAllStops() const {
-		return deque_stops_;
+	const domain::Stop& TransportCatalogue::GetStop(domain::StopId stop) const {
+		return deque_stops_[stop];
 	}
 
-	const std::unordered_map<std::pair<std::string_view, std::string_view>, std::size_t, domain::Hasher>& TransportCatalogue::GetDestinations() const {
-		return destinations_;
+	const domain::Bus& TransportCatalogue::GetBus(domain::BusId bus) const {
+		return deque_buses_[bus];
 	}
 
-	const std::deque<domain::Bus>& TransportCatalogue::GetAllBuses() const {
-		return deque_buses_;
-	}
+	std::size_t TransportCatalogue::GetDistance(domain::StopId from, domain::StopId to) const {
+		using namespace std::literals;
 
-	std::optional<const std::set<domain::Bus*, domain::Compartor>*> TransportCatalogue::GetBusesForStop(std::string_view stop) const {
-		if (stops_.contains(stop)) {
-			return &stops_.at(stop);
+		if (!are_distances_packed_) {
+			return destinations_.at(std::make_pair(from, to));
 		}
 
-		return std::nullopt;
+		auto row_begin = distance_targets_.begin() + distance_offsets_[from];
+		auto row_end = distance_targets_.begin() + distance_offsets_[from + 1];
+		auto it = std::lower_bound(row_begin, row_end, to);
+
+		if (it == row_end || *it != to) {
+			throw std::out_of_range("No road distance between the stops"s);
+		}
+
+		return distance_lengths_[it - distance_targets_.begin()];
 	}
 
-	std::optional<const domain::Bus*> TransportCatalogue::FindBus(std::string_view bus) const {
-		auto it = std::ranges::find(deque_buses_, bus, [](const domain::Bus& range_bus) {
-			return range_bus.name;
-		});
+	std::span<const std::uint32_t> TransportCatalogue::GetSegmentDistances(domain::BusId bus) const {
+		return std::span<const std::uint32_t>(segment_distances_).subspan(segment_offsets_[bus],
+			segment_offsets_[bus + 1] - segment_offsets_[bus]);
+	}
+
+	const domain::Snapshot& TransportCatalogue::GetSnapshot() const {
+		return snapshot_;
+	}
+
+	const std::deque<domain::Stop>& TransportCatalogue::GetAllStops() const {
+		return deque_stops_;
+	}
+
+	const std::deque<domain::Bus>& TransportCatalogue::GetAllBuses() const {
+		return deque_buses_;
+	}
 
-		if (it != deque_buses_.end()) {
-			return &*it;
+	std::optional<const domain::Bus*> TransportCatalogue::FindBus(std::string_view bus) const {
+		if (auto it = bus_index_.find(bus); it != bus_index_.end()) {
+			return it->second;
 		}
 
 		return std::nullopt;
 	}
 
-	std::optional<const std::vector<domain::Stop*>*> TransportCatalogue::GetStopsForBus(std::string_view bus) const {
-		std::optional<const domain::Bus*> bus_to_process = FindBus(bus);
-
-		if (bus_to_process.has_value()) {
-			return &bus_to_process.value()->stops_with_duplicates;
+	std::optional<const domain::Stop*> TransportCatalogue::FindStop(std::string_view stop) const {
+		if (auto it = stop_index_.find(stop); it != stop_index_.end()) {
+			return it->second;
 		}
 
 		return std::nullopt;
@@ -151,25 +336,56 @@ namespace catalogue {
 //                                                           + -------------------
 // ----------------------------------------------------------- Computing methods +
 
-	std::size_t TransportCatalogue::ComputeActualLength(std::string_view bus) const {
+	domain::BusInfo TransportCatalogue::ComputeBusInfo(const domain::Bus& bus) const {
+		domain::BusInfo to_output;
+
+		to_output.name = bus.name;
+		to_output.stops_on_route = bus.stops_with_duplicates.size();
+		to_output.unique_stops = unique_stops_[bus.id];
+
+		to_output.actual_distance = ComputeActualLength(bus);
+		to_output.pure_distance = ComputePureLength(bus);
+		to_output.curvature = to_output.actual_distance / to_output.pure_distance;
+
+		to_output.is_found = true;
+		return to_output;
+	}
+
+	domain::BusInfo TransportCatalogue::ComputeFrozenBusInfo(domain::BusId bus, const geo::PointsTrigonometry& stops_trigonometry) const {
+		const std::span<const std::uint32_t> segments = GetSegmentDistances(bus);
+		domain::BusInfo to_output;
+
+		to_output.name = snapshot_.bus_names[bus];
+		to_output.stops_on_route = snapshot_.GetBusStops(bus).size();
+		to_output.unique_stops = unique_stops_[bus];
+
+		to_output.actual_distance = std::accumulate(segments.begin(), segments.end(), std::size_t{});
+		to_output.pure_distance = geo::ComputePolylineLength(stops_trigonometry, snapshot_.GetBusStops(bus));
+		to_output.curvature = to_output.actual_distance / to_output.pure_distance;
+
+		to_output.is_found = true;
+		return to_output;
+	}
+
+	std::size_t TransportCatalogue::ComputeActualLength(const domain::Bus& bus) const {
 		std::size_t actual_distance = 0;
-		std::optional<const std::vector<domain::Stop*>*> stops = GetStopsForBus(bus).value();
+		const std::vector<domain::Stop*>& stops = bus.stops_with_duplicates;
 
-		for (auto it = stops.value()->rbegin(); it != stops.value()->rend() - 1; ++it) {
+		for (auto it = stops.rbegin(); it != stops.rend() - 1; ++it) {
 			domain::Stop* current_stop = *it;
 			domain::Stop* previous_stop = *(it + 1);
-			actual_distance += destinations_.at(std::make_pair(previous_stop->name, current_stop->name));
+			actual_distance += GetDistance(previous_stop->id, current_stop->id);
 		}
 
 		return actual_distance;
 	}
 
-	double TransportCatalogue::ComputePureLength(std::string_view bus) const {
+	double TransportCatalogue::ComputePureLength(const domain::Bus& bus) const {
 		double pure_distance = 0.0;
 		geo::Coordinates first, second;
 
 		bool is_first = true;
-		for (const auto& stop : *GetStopsForBus(bus).value()) {
+		for (const auto& stop : bus.stops_with_duplicates) {
 			first = stop->coordinates;
 			if (!is_first) {
 				pure_distance += geo::ComputeDistance(first, second);
@@ -180,8 +396,4 @@ namespace catalogue {
 
 		return pure_distance;
 	}
-
-	std::size_t TransportCatalogue::ReturnAmoutOfUniqueStopsForBus(std::string_view bus) const {
-		return buses_.at(bus).size();
-	}
-} // namespace catalogue
\ No newline at end of file
+} // namespace catalogue
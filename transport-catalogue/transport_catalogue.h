@@ -1,8 +1,14 @@
 #pragma once
 
 #include <cstddef>
-#include <set>
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
+#include <optional>
 #include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "domain.h"
 #include "graph.h"
@@ -15,9 +21,19 @@ namespace catalogue {
 
 	class TransportCatalogue final {
 	public:
-		void AddStop(const std::string& stop, const geo::Coordinates& coordinates);
-		void AddDestination(const std::string& stop, const std::string& dst, const std::size_t length);
-		void AddBus(const std::string& bus, std::span<const std::string_view> proper_stops, bool is_roundtrip);
+		// Names are copied into the catalogue's own storage. Throw std::invalid_argument on a stop not added yet
+		void AddStop(std::string_view stop, const geo::Coordinates& coordinates);
+		void AddDestination(std::string_view stop, std::string_view dst, const std::size_t length);
+		void AddBus(std::string_view bus, std::span<const std::string_view> proper_stops, bool is_roundtrip);
+
+		// Same as above for stops that have already been resolved to their ids
+		void AddDestination(domain::StopId stop, domain::StopId dst, const std::size_t length);
+		void AddBus(std::string_view bus, std::span<const domain::StopId> proper_stops, bool is_roundtrip);
+
+		// Builds the read-only snapshot, packs road distances into flat arrays and precomputes
+		// the statistics of every bus, so that GetBusInfo() is served in O(1).
+		// Must be called once all the stops, destinations and buses have been added
+		void Freeze();
 
 		domain::Bus* FindBus(std::string_view bus);
 		domain::Stop* FindStop(std::string_view stop);
@@ -25,23 +41,61 @@ namespace catalogue {
 		const domain::BusInfo GetBusInfo(std::string_view bus) const;
 		const domain::StopInfo GetStopInfo(std::string_view stop) const;
 
+		const domain::Stop& GetStop(domain::StopId stop) const;
+		const domain::Bus& GetBus(domain::BusId bus) const;
+		std::size_t GetDistance(domain::StopId from, domain::StopId to) const;
+
+		// Road distances between consecutive stops of a bus: [i] is the length from stop i to stop i + 1.
+		// Available after Freeze()
+		std::span<const std::uint32_t> GetSegmentDistances(domain::BusId bus) const;
+
+		// Available after Freeze()
+		const domain::Snapshot& GetSnapshot() const;
+
 		const std::deque<domain::Stop>& GetAllStops() const;
-		const std::unordered_map<std::pair<std::string_view, std::string_view>, std::size_t, domain::Hasher>& GetDestinations() const;
 		const std::deque<domain::Bus>& GetAllBuses() const;
 
 	private:
-		size_t ComputeActualLength(std::string_view bus) const;
-		double ComputePureLength(std::string_view bus) const;
-		std::optional<const std::set<domain::Bus*, domain::Compartor>*> GetBusesForStop(std::string_view stop) const;
-		std::optional<const std::vector<domain::Stop*>*> GetStopsForBus(std::string_view bus) const;
+		std::string_view StoreName(std::string_view name);
+
+		void BuildSnapshot();
+		void PackDistances();
+
+		domain::BusInfo ComputeBusInfo(const domain::Bus& bus) const;
+		domain::BusInfo ComputeFrozenBusInfo(domain::BusId bus, const geo::PointsTrigonometry& stops_trigonometry) const;
+		size_t ComputeActualLength(const domain::Bus& bus) const;
+		double ComputePureLength(const domain::Bus& bus) const;
 		std::optional<const domain::Bus*> FindBus(std::string_view bus) const;
-		std::size_t ReturnAmoutOfUniqueStopsForBus(std::string_view bus) const;
+		std::optional<const domain::Stop*> FindStop(std::string_view stop) const;
+
+		// Names of all stops and buses are bump-allocated in large blocks and released at once
+		std::pmr::monotonic_buffer_resource names_;
 
 		std::deque<domain::Bus> deque_buses_;
 		std::deque<domain::Stop> deque_stops_;
+
+		std::unordered_map<std::string_view, domain::Bus*> bus_index_;
+		std::unordered_map<std::string_view, domain::Stop*> stop_index_;
 		
-		std::unordered_map<std::string_view, std::unordered_set<domain::Stop*>> buses_;
-		std::unordered_map<std::pair<std::string_view, std::string_view>, std::size_t, domain::Hasher> destinations_;
-		std::unordered_map<std::string_view, std::set<domain::Bus*, domain::Compartor>> stops_;
+		// Indexed by domain::BusId / domain::StopId respectively. [stop_buses_] is released by Freeze()
+		std::vector<std::size_t> unique_stops_;
+		std::vector<std::vector<domain::BusId>> stop_buses_;
+
+		// Filled while loading, then packed by Freeze() and released
+		std::unordered_map<std::pair<domain::StopId, domain::StopId>, std::size_t, domain::Hasher> destinations_;
+
+		// Road distances in CSR layout: the row of a stop is [distance_offsets_[id], distance_offsets_[id + 1])
+		// of distance_targets_ (sorted) and distance_lengths_
+		std::vector<std::uint32_t> distance_offsets_;
+		std::vector<domain::StopId> distance_targets_;
+		std::vector<std::uint32_t> distance_lengths_;
+
+		std::vector<std::uint32_t> segment_offsets_;
+		std::vector<std::uint32_t> segment_distances_;
+
+		domain::Snapshot snapshot_;
+		std::vector<domain::BusInfo> bus_infos_;
+		bool are_distances_packed_ = false;
+		bool is_frozen_ = false;
 	};
 } // namespace catalogue
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <ranges>
 
 #include "transport_router.h"
@@ -10,58 +11,195 @@ namespace transport_router {
 
 	TransportRouter::TransportRouter(catalogue::TransportCatalogue& database, const domain::RoutingSettings& routing_settings)
 		: database_(database) 
-		, routing_settings_(routing_settings)
-		, graph_(database.GetAllStops().size() * 2) {
+		, routing_settings_(routing_settings) {
+
+		// The round-based engine rides the buses' stop sequences and needs no graph
+		if (routing_settings_.engine == domain::RouterEngine::RAPTOR) {
+			raptor_router_ = std::make_unique<RaptorRouter>(database_, routing_settings_);
+			return;
+		}
 
 		FillRouter();
 	}
 
-	void TransportRouter::CreateTransfers() {
-		std::size_t index = 0;
+	void TransportRouter::FillGraph() {
+		const domain::Snapshot& snapshot = database_.GetSnapshot();
+		graph_builder_ = graph::DirectedWeightedGraph<double>(snapshot.GetStopCount());
 
-		for (auto it = database_.GetAllStops().begin(); it != database_.GetAllStops().end(); ++it, index += 2) {
-			graph_stops_.push_back(*it);
-			graph_stops_.push_back(*it);
+		for (domain::BusId bus : std::views::iota(domain::BusId{}, static_cast<domain::BusId>(snapshot.GetBusCount()))) {
+			const std::span<const domain::StopId> stops_with_duplicates = snapshot.GetBusStops(bus);
+			const std::span<const std::uint32_t> segments = database_.GetSegmentDistances(bus);
+
+			if (stops_with_duplicates.empty()) {
+				continue;
+			}
 
-			stop_indexes_[it->name] = index;
+			// A linear bus is ridden forward up to its terminal stop and then backward from it
+			if (!snapshot.are_roundtrips[bus]) {
+				const std::size_t terminal = stops_with_duplicates.size() / 2;
+				FillGraphWithBuses(stops_with_duplicates.first(terminal + 1), bus, segments);
+				FillGraphWithBuses(stops_with_duplicates.subspan(terminal), bus, segments.subspan(terminal));
+			}
+			else {
+				FillGraphWithBuses(stops_with_duplicates, bus, segments);
+			}
 		}
 
-		for (std::size_t index = 0; index != graph_stops_.size(); ++index) {
-			graph_.AddEdge(graph::Edge<double> {
-				.from = index,
-				.to = ++index,
-				.weight = routing_settings_.bus_wait_time * 1.0
-			});
+		AddSpanEdges();
+	}
+
+	// Every ordered pair of stops is a candidate edge, weighted with the wait before boarding. The distance of a span is a difference of two prefix sums
+	void TransportRouter::FillGraphWithBuses(std::span<const domain::StopId> stops, domain::BusId bus, std::span<const std::uint32_t> segments) {
+		distance_prefixes_.assign(1, 0);
+		for (std::size_t position = 0; position + 1 < stops.size(); ++position) {
+			distance_prefixes_.push_back(distance_prefixes_.back() + segments[position]);
+		}
+
+		for (std::size_t begin = 0; begin + 1 < stops.size(); ++begin) {
+			const domain::StopId beginning_stop = stops[begin];
+
+			for (std::size_t end = stops.size() - 1; end > begin; --end) {
+				const domain::StopId ending_stop = stops[end];
+				const double length = static_cast<double>(distance_prefixes_[end] - distance_prefixes_[begin]);
+				const double time = length / 1000.0 / routing_settings_.bus_velocity * 60;
+
+				AddSpanCandidate(SpanEdge {
+					.edge = graph::Edge<double> {
+						.from = GetVertex(beginning_stop),
+						.to = GetVertex(ending_stop),
+						.weight = routing_settings_.bus_wait_time + time
+					},
+					.info = EdgeInfo {
+						.bus = bus,
+						.span_count = static_cast<std::uint32_t>(end - begin),
+						.time = time
+					}
+				});
+			}
 		}
 	}
 
-	void TransportRouter::FillGraph() {
-		CreateTransfers();
+	// Parallel edges of a stop pair are dominated by the lightest one, then by the one with fewer spans
+	void TransportRouter::AddSpanCandidate(const SpanEdge& candidate) {
+		const std::pair<domain::StopId, domain::StopId> stops{ GetStopId(candidate.edge.from), GetStopId(candidate.edge.to) };
+		const auto [position, is_inserted] = span_edge_indexes_.try_emplace(stops, span_edges_.size());
+
+		if (is_inserted) {
+			span_edges_.push_back(candidate);
+			return;
+		}
+
+		SpanEdge& current = span_edges_[position->second];
+		if (candidate.edge.weight < current.edge.weight
+			|| (candidate.edge.weight == current.edge.weight && candidate.info.span_count < current.info.span_count)) {
+			current = candidate;
+		}
+	}
+
+	void TransportRouter::AddSpanEdges() {
+		for (const SpanEdge& span_edge : span_edges_) {
+			graph_builder_.AddEdge(span_edge.edge);
+			edge_infos_.push_back(span_edge.info);
+		}
+
+		span_edge_indexes_ = {};
+		span_edges_ = {};
+	}
 
-		for (std::size_t deque_index : std::views::iota(0ULL, database_.GetAllBuses().size())) {
-			const std::vector<domain::Stop*>* stops_with_duplicates = &database_.GetAllBuses()[deque_index].stops_with_duplicates;
+	void TransportRouter::FillRouter() {
+		FillGraph();
 
-			if (!database_.GetAllBuses()[deque_index].is_roundtrip) {
-				auto forward_range_begin = stops_with_duplicates->begin();
-				auto forward_range_end = stops_with_duplicates->begin() + stops_with_duplicates->size() / 2;
-				FillGraphWithBuses(forward_range_begin, forward_range_end, database_.GetAllBuses()[deque_index].name);
+		// The mutable graph is only needed while the edges are being added. Fixed-point engines
+		// only choose the route: its times are taken from [edge_infos_] by BuildGraphRoute()
+		if (routing_settings_.engine == domain::RouterEngine::DIJKSTRA_FIXED_POINT
+			|| routing_settings_.engine == domain::RouterEngine::COMPACT_FLOYD_WARSHALL) {
+			fixed_graph_ = graph::CsrGraph<domain::FixedTime>(graph_builder_, domain::ToFixedTime);
+			graph_builder_ = {};
 
-				auto backward_range_begin = stops_with_duplicates->begin() + stops_with_duplicates->size() / 2;
-				auto backward_range_end = stops_with_duplicates->end() - 1;
-				FillGraphWithBuses(backward_range_begin, backward_range_end, database_.GetAllBuses()[deque_index].name);
+			if (routing_settings_.engine == domain::RouterEngine::COMPACT_FLOYD_WARSHALL) {
+				fixed_router_ = std::make_unique<graph::BlockedFloydRouter<domain::FixedTime>>(fixed_graph_);
 			}
 			else {
-				auto round_range_begin = stops_with_duplicates->begin();
-				auto round_range_end = stops_with_duplicates->end() - 1;
+				fixed_router_ = std::make_unique<graph::DijkstraRouter<domain::FixedTime>>(fixed_graph_);
+			}
+
+			return;
+		}
+
+		graph_ = graph::CsrGraph<double>(graph_builder_);
+		graph_builder_ = {};
+
+		switch (routing_settings_.engine) {
+		case domain::RouterEngine::BLOCKED_FLOYD_WARSHALL:
+			router_ = std::make_unique<graph::BlockedFloydRouter<double>>(graph_);
+			break;
+
+		case domain::RouterEngine::DIJKSTRA:
+			router_ = std::make_unique<graph::DijkstraRouter<double>>(graph_);
+			break;
+
+		case domain::RouterEngine::CONTRACTION_HIERARCHY:
+			router_ = std::make_unique<graph::ContractionHierarchyRouter<double>>(graph_);
+			break;
+
+		case domain::RouterEngine::ROW_CACHE:
+			router_ = std::make_unique<graph::RowCacheRouter<double>>(graph_, routing_settings_.row_cache_budget);
+			break;
+
+		case domain::RouterEngine::A_STAR:
+			router_ = std::make_unique<graph::AStarRouter<double, GeoHeuristic>>(graph_, MakeGeoHeuristic());
+			break;
+
+		case domain::RouterEngine::ALT:
+			router_ = std::make_unique<graph::AStarRouter<double, graph::LandmarkHeuristic<double>>>(graph_,
+				graph::LandmarkHeuristic<double>(graph_, LANDMARK_COUNT));
+			break;
+
+		default:
+			router_ = std::make_unique<graph::Router<double>>(graph_);
+		}
+	}
+
+// 
+// 
+//                                                        + ----------------
+// -------------------------------------------------------- Geo Heuristic +
+
+	TransportRouter::GeoHeuristic TransportRouter::MakeGeoHeuristic() {
+		const domain::Snapshot& snapshot = database_.GetSnapshot();
+		stops_trigonometry_ = geo::ComputeTrigonometry(snapshot.latitudes, snapshot.longitudes);
+
+		// Road distances may be shorter than the geodesic ones, so the bound shrinks by the least ratio seen
+		double road_ratio = 1.0;
+		for (domain::BusId bus = 0; bus < snapshot.GetBusCount(); ++bus) {
+			const std::span<const domain::StopId> stops = snapshot.GetBusStops(bus);
+			const std::span<const std::uint32_t> segments = database_.GetSegmentDistances(bus);
 
-				FillGraphWithBuses(round_range_begin, round_range_end, database_.GetAllBuses()[deque_index].name);
+			for (std::size_t segment = 0; segment < segments.size(); ++segment) {
+				const double geodesic = geo::ComputeDistance(stops_trigonometry_, stops[segment], stops[segment + 1]);
+
+				if (geodesic > 0.0) {
+					road_ratio = std::min(road_ratio, segments[segment] / geodesic);
+				}
 			}
 		}
+
+		// The margin covers the rounding of the batched geodesic distance
+		constexpr double MARGIN = 0.999;
+
+		return GeoHeuristic {
+			.stops = &stops_trigonometry_,
+			.wait_time = routing_settings_.bus_wait_time * 1.0,
+			.minutes_per_meter = road_ratio * MARGIN / 1000.0 / routing_settings_.bus_velocity * 60
+		};
 	}
 
-	void TransportRouter::FillRouter() {
-		FillGraph();
-		router_ = std::make_unique<graph::Router<double>>(graph_);
+	double TransportRouter::GeoHeuristic::operator()(graph::VertexId vertex, graph::VertexId target) const {
+		if (vertex == target) {
+			return 0.0;
+		}
+
+		return wait_time + geo::ComputeDistance(*stops, GetStopId(vertex), GetStopId(target)) * minutes_per_meter;
 	}
 
 // 
@@ -69,14 +207,53 @@ namespace transport_router {
 //                                                        + --------------------
 // -------------------------------------------------------- Retrieving methods +
 
-	const domain::Data TransportRouter::GetDataToBuildOptimalRoute(std::string_view from, std::string_view to) {
-		return domain::Data {
-			.route = router_->BuildRoute(stop_indexes_.at(from), stop_indexes_.at(to)),
-			.graph = graph_,
-			.router = router_.get(),
-			.bus_wait_time = routing_settings_.bus_wait_time,
-			.graph_stops = graph_stops_,
-			.spans = spans_
-		};
+	std::optional<domain::Route> TransportRouter::BuildRoute(domain::StopId from, domain::StopId to) const {
+		if (raptor_router_) {
+			return raptor_router_->BuildRoute(from, to);
+		}
+
+		if (fixed_router_) {
+			return BuildGraphRoute(fixed_graph_, *fixed_router_, from, to);
+		}
+
+		return BuildGraphRoute(graph_, *router_, from, to);
+	}
+
+	std::optional<double> TransportRouter::ComputeTravelTime(domain::StopId from, domain::StopId to) const {
+		if (!router_) {
+			const std::optional<domain::Route> route = BuildRoute(from, to);
+			return route.has_value() ? std::optional<double>(route->total_time) : std::nullopt;
+		}
+
+		std::call_once(travel_time_index_flag_, [this] {
+			travel_time_index_ = std::make_unique<graph::HubLabels<double>>(graph_);
+		});
+
+		return travel_time_index_->ComputeWeight(GetVertex(from), GetVertex(to));
+	}
+
+	std::optional<graph::RowCacheRouter<double>::CacheStats> TransportRouter::GetRowCacheStats() const {
+		if (routing_settings_.engine != domain::RouterEngine::ROW_CACHE) {
+			return std::nullopt;
+		}
+
+		return static_cast<const graph::RowCacheRouter<double>&>(*router_).GetCacheStats();
+	}
+
+	std::optional<TransportRouter::TravelTimeIndexStats> TransportRouter::GetTravelTimeIndexStats() const {
+		if (!travel_time_index_) {
+			return std::nullopt;
+		}
+
+		return TravelTimeIndexStats{ .entry_count = travel_time_index_->GetEntryCount(),
+			.memory_usage = travel_time_index_->GetMemoryUsage() };
+	}
+
+	domain::StopId TransportRouter::GetStopId(graph::VertexId vertex) {
+		return static_cast<domain::StopId>(vertex);
+	}
+
+	graph::VertexId TransportRouter::GetVertex(domain::StopId stop) {
+		return static_cast<graph::VertexId>(stop);
 	}
 } // namespace transport_router
\ No newline at end of file
@@ -1,11 +1,28 @@
 #pragma once
 
-#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-
+#include <mutex>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "astar_router.h"
+#include "blocked_floyd_router.h"
+#include "contraction_hierarchy.h"
+#include "csr_graph.h"
+#include "dijkstra_router.h"
 #include "domain.h"
+#include "geo.h"
 #include "graph.h"
+#include "hub_labels.h"
+#include "raptor_router.h"
 #include "router.h"
+#include "row_cache_router.h"
 #include "transport_catalogue.h"
 
 namespace transport_router {
@@ -17,72 +34,128 @@ namespace transport_router {
 	class TransportRouter final {
 	public:
 		TransportRouter(catalogue::TransportCatalogue& database, const domain::RoutingSettings& routing_settings);
-		const domain::Data GetDataToBuildOptimalRoute(std::string_view from, std::string_view to);
-		
+		std::optional<domain::Route> BuildRoute(domain::StopId from, domain::StopId to) const;
+
+		// Total time only, answered by a hub-label index built on the first call. Engines without
+		// a floating-point graph fall back to building the route
+		std::optional<double> ComputeTravelTime(domain::StopId from, domain::StopId to) const;
+
+		// Counters of the row_cache engine, empty for the other engines
+		std::optional<graph::RowCacheRouter<double>::CacheStats> GetRowCacheStats() const;
+
+		struct TravelTimeIndexStats final {
+			std::size_t entry_count = 0;
+			std::size_t memory_usage = 0;
+		};
+
+		// Size of the hub-label index, empty until a ComputeTravelTime call has built it
+		std::optional<TravelTimeIndexStats> GetTravelTimeIndexStats() const;
+
 	private:
-		void CreateTransfers();
 		void FillGraph();
 		void FillRouter();
 
-		template <std::random_access_iterator RandomIt>
-		void FillGraphWithBuses(RandomIt stop_range_begin, RandomIt stop_range_end, const std::string& bus_name);
+		// Turns the graph edges of a route into Wait and Bus items; fixed-point totals are summed from the edge times
+		template <typename Weight>
+		std::optional<domain::Route> BuildGraphRoute(const graph::CsrGraph<Weight>& graph, const graph::RoutingEngine<Weight>& router,
+			domain::StopId from, domain::StopId to) const;
+
+		// Bus ride an edge stands for, indexed by EdgeId. [time] excludes the wait folded into the edge
+		struct EdgeInfo final {
+			domain::BusId bus = {};
+			std::uint32_t span_count = 0;
+			double time = {};
+		};
+
+		struct SpanEdge final {
+			graph::Edge<double> edge;
+			EdgeInfo info;
+		};
+
+		// [segments] holds the road distances between consecutive [stops]
+		void FillGraphWithBuses(std::span<const domain::StopId> stops, domain::BusId bus, std::span<const std::uint32_t> segments);
+		void AddSpanCandidate(const SpanEdge& candidate);
+		void AddSpanEdges();
+
+		// Admissible A* bound: a wait plus the geodesic distance to the target, scaled by the least
+		// road / geodesic ratio among the bus segments and ridden at the bus velocity
+		struct GeoHeuristic final {
+			const geo::PointsTrigonometry* stops = nullptr;
+			double wait_time = {};
+			double minutes_per_meter = {};
+
+			double operator()(graph::VertexId vertex, graph::VertexId target) const;
+		};
+
+		GeoHeuristic MakeGeoHeuristic();
 
-		std::unordered_map<std::pair<std::string_view, std::string_view>, std::map<std::size_t, std::deque<std::string_view>>, domain::Hasher> spans_;
-		std::unordered_map<std::string_view, std::size_t> stop_indexes_;
+		// Every stop is a single vertex: an edge is a wait at its beginning stop followed by a bus ride
+		static graph::VertexId GetVertex(domain::StopId stop);
+		static domain::StopId GetStopId(graph::VertexId vertex);
+
+		static constexpr std::size_t LANDMARK_COUNT = 8;
 
 		catalogue::TransportCatalogue& database_;
 		domain::RoutingSettings routing_settings_;
-		graph::DirectedWeightedGraph<double> graph_;
-
-		std::deque<domain::Stop> graph_stops_;
-		std::unique_ptr<graph::Router<double>> router_;
+		graph::DirectedWeightedGraph<double> graph_builder_;
+		std::vector<std::uint64_t> distance_prefixes_;
+		std::unordered_map<std::pair<domain::StopId, domain::StopId>, std::size_t, domain::Hasher> span_edge_indexes_;
+		std::vector<SpanEdge> span_edges_;
+		std::vector<EdgeInfo> edge_infos_;
+		geo::PointsTrigonometry stops_trigonometry_;
+		graph::CsrGraph<double> graph_;
+		std::unique_ptr<graph::RoutingEngine<double>> router_;
+		graph::CsrGraph<domain::FixedTime> fixed_graph_;
+		std::unique_ptr<graph::RoutingEngine<domain::FixedTime>> fixed_router_;
+		std::unique_ptr<RaptorRouter> raptor_router_;
+		mutable std::once_flag travel_time_index_flag_;
+		mutable std::unique_ptr<graph::HubLabels<double>> travel_time_index_;
 	};
 
 // 
 // 
-//                                                       + --------------------------
-// ------------------------------------------------------- Filling Graph with Buses +
+//                                                       + -------------------
+// ------------------------------------------------------- Graph Route Items +
+
+	template <typename Weight>
+	std::optional<domain::Route> TransportRouter::BuildGraphRoute(const graph::CsrGraph<Weight>& graph, const graph::RoutingEngine<Weight>& router,
+		domain::StopId from, domain::StopId to) const {
+		const auto route_info = router.BuildRoute(GetVertex(from), GetVertex(to));
 
-	template <std::random_access_iterator RandomIt>
-	void TransportRouter::FillGraphWithBuses(RandomIt global_begin, RandomIt global_end, const std::string& bus_name) {
-		auto stop_range_begin = global_begin;
-		auto stop_range_end = global_end;
+		if (!route_info.has_value()) {
+			return std::nullopt;
+		}
 
-		domain::Stop* beginning_stop = *stop_range_begin;
-		std::size_t beginning_stop_index = stop_indexes_.at(beginning_stop->name);
+		// Fixed-point weights only order the search: the total is summed from the exact edge times
+		// in the same order as the double engines do, so that all engines print the same totals
+		domain::Route route{ .total_time = {}, .items = {} };
+		if constexpr (!std::is_same_v<Weight, domain::FixedTime>) {
+			route.total_time = route_info->weight;
+		}
 
-		while (global_begin != global_end) {
-			const domain::Stop* ending_stop = *stop_range_end;
-			const std::size_t ending_stop_index = stop_indexes_.at(ending_stop->name);
-			auto stop_iterator = stop_range_begin;
-			double length = {};
+		route.items.reserve(route_info->edges.size() * 2);
 
-			while (stop_iterator != stop_range_end) {
-				const domain::Stop* next_stop = *std::ranges::next(stop_iterator, 1);
-				length += database_.GetDestinations().at(std::make_pair((*stop_iterator)->name, next_stop->name));
+		for (const graph::EdgeId edge_id : route_info->edges) {
+			const EdgeInfo& edge_info = edge_infos_[edge_id];
 
-				std::ranges::advance(stop_iterator, 1);
+			if constexpr (std::is_same_v<Weight, domain::FixedTime>) {
+				route.total_time += routing_settings_.bus_wait_time + edge_info.time;
 			}
 
-			double weight = length / 1000.0 / routing_settings_.bus_velocity * 60;
-			graph_.AddEdge(graph::Edge<double> {
-				.from = beginning_stop_index + 1,
-				.to = ending_stop_index,
-				.weight = weight
+			route.items.push_back(domain::RouteItem{
+				.type = domain::RouteItem::Type::WAIT,
+				.stop = GetStopId(graph.GetEdge(edge_id).from),
+				.time = routing_settings_.bus_wait_time * 1.0
 			});
-			spans_[{ beginning_stop->name, ending_stop->name }][static_cast<std::size_t>(std::ranges::distance(stop_range_begin, stop_range_end))].push_back(bus_name);
-
-			std::ranges::advance(stop_range_end, -1);
 
-			if (stop_range_begin == stop_range_end) {
-				std::ranges::advance(global_begin, 1);
-
-				stop_range_begin = global_begin;
-				stop_range_end = global_end;
-
-				beginning_stop = *stop_range_begin;
-				beginning_stop_index = stop_indexes_.at(beginning_stop->name);
-			}
+			route.items.push_back(domain::RouteItem{
+				.type = domain::RouteItem::Type::BUS,
+				.bus = edge_info.bus,
+				.span_count = edge_info.span_count,
+				.time = edge_info.time
+			});
 		}
+
+		return route;
 	}
 } // namespace transport_router
\ No newline at end of file